@@ -73,8 +73,8 @@ if(WINDOWS)
       set(CMAKE_LIBRARY_PATH ${CMAKE_LIBRARY_PATH} "${PROJECT_SOURCE_DIR}/extlibs/libs-mingw/x64")
     endif()
 
-    # require proper c++
-    ADD_DEFINITIONS("-Wall -lstdc++")
+    # require proper c++ (C++11 is needed for std::thread, std::mutex and std::atomic)
+    ADD_DEFINITIONS("-Wall -std=c++11 -lstdc++")
   elseif(COMPILER_MSVC)
     # Specify where to find DLL and LIB files according to 32bit or 64bit compiling
     if(ARCH_32BITS)
@@ -102,13 +102,13 @@ if(WINDOWS)
 elseif(LINUX)
   set(CMAKE_LIBRARY_PATH ${CMAKE_LIBRARY_PATH} "${PROJECT_SOURCE_DIR}/extlibs/libs-gcc")
 
-  # require proper c++
-  ADD_DEFINITIONS("-Wall")
+  # require proper c++ (C++11 is needed for std::thread, std::mutex and std::atomic)
+  ADD_DEFINITIONS("-Wall -std=c++11")
 elseif(MACOSX)
   set(CMAKE_LIBRARY_PATH ${CMAKE_LIBRARY_PATH} "${PROJECT_SOURCE_DIR}/extlibs/libs-osx/lib/")
 
-  # require proper c++
-  ADD_DEFINITIONS("-Wall")
+  # require proper c++ (C++11 is needed for std::thread, std::mutex and std::atomic)
+  ADD_DEFINITIONS("-Wall -std=c++11")
 endif()
 
 # offer the user the choice of overriding the installation directories
@@ -0,0 +1,343 @@
+/**
+* Provides the gexl-bench-assets benchmark measuring the throughput and
+* latency of the asset lookup, acquire and release paths.
+*
+* @file bench/AssetBench/AssetBench.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <GExL/assets/AssetManager.hpp>
+#include <GExL/assets/TAsset.hpp>
+
+/// Number of operations timed together for each latency sample
+const GExL::Uint32 BATCH_SIZE = 64;
+
+/// Number of operations each thread runs for every benchmark
+const GExL::Uint32 OPERATION_COUNT = 2000000;
+
+/// Simple asset type used by the benchmark
+struct BenchAsset
+{
+  BenchAsset() : value(0) {}
+  GExL::Uint32 value;
+};
+
+/// Asset type of the handler used to create and delete assets, a separate
+/// type so the same asset ID's can be used without finding the warm assets
+struct BenchColdAsset : public BenchAsset
+{
+};
+
+/// Asset handler that "loads" each asset from memory instantly
+template <class TYPE>
+class BenchHandler : public GExL::TAssetHandler<TYPE>
+{
+protected:
+  virtual bool LoadFromFile(const GExL::typeAssetID theAssetID, TYPE& theAsset)
+  {
+    theAsset.value = (GExL::Uint32)theAssetID.size();
+    return true;
+  }
+  virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID,
+    const GExL::AssetSpan& theData, TYPE& theAsset)
+  {
+    return false;
+  }
+  virtual bool LoadFromNetwork(const GExL::typeAssetID theAssetID, TYPE& theAsset)
+  {
+    return false;
+  }
+};
+
+/// Everything each benchmark needs for one asset count
+struct typeBenchState
+{
+  GExL::AssetManager*                     assetManager; ///< Manager holding the handlers
+  const std::vector<GExL::AssetKey>*      keys;         ///< Key of each asset
+  std::vector<GExL::TAsset<BenchAsset> >  assets;       ///< Loaded warm assets
+  GExL::Uint32                            assetCount;   ///< Number of assets used
+  GExL::Uint32                            loadedAssets; ///< Warm assets acquired and loaded
+  GExL::Uint32                            threadCount;  ///< Number of threads used
+  GExL::Uint64                            checksum;     ///< Keeps the work from being optimized out
+};
+
+/// Operation measured by each benchmark for theIndex asset on theThread
+typedef GExL::Uint64 (*typeBenchOperation)(typeBenchState& theState,
+  GExL::Uint32 theIndex, GExL::Uint32 theThread);
+
+/// Steady state TAsset::GetAsset of an asset already loaded
+GExL::Uint64 BenchGetAsset(typeBenchState& theState, GExL::Uint32 theIndex,
+  GExL::Uint32 theThread)
+{
+  return theState.assets[theIndex].GetAsset().value;
+}
+
+/// AssetManager::GetHandler lookup done by every TAsset constructor
+GExL::Uint64 BenchGetHandler(typeBenchState& theState, GExL::Uint32 theIndex,
+  GExL::Uint32 theThread)
+{
+  return (GExL::Uint64)(size_t)&theState.assetManager->GetHandler<BenchAsset>();
+}
+
+/// GetReference and DropReference by key of an asset already referenced
+GExL::Uint64 BenchGetReference(typeBenchState& theState, GExL::Uint32 theIndex,
+  GExL::Uint32 theThread)
+{
+  GExL::TAssetHandler<BenchAsset>& anHandler =
+    theState.assetManager->GetHandler<BenchAsset>();
+  const GExL::AssetKey& anKey = (*theState.keys)[theIndex];
+  GExL::Uint64 anResult = anHandler.GetReference(anKey)->value;
+  anHandler.DropReference(anKey);
+  return anResult;
+}
+
+/// TAsset copy and destroy which only touch the reference count
+GExL::Uint64 BenchCopyAsset(typeBenchState& theState, GExL::Uint32 theIndex,
+  GExL::Uint32 theThread)
+{
+  GExL::TAsset<BenchAsset> anCopy(theState.assets[theIndex]);
+  return anCopy.IsLoaded() ? 1 : 0;
+}
+
+/// GetReference of a new asset and DropReference deleting it again, each
+/// thread uses its own assets so every call creates and deletes one
+GExL::Uint64 BenchAcquireRelease(typeBenchState& theState, GExL::Uint32 theIndex,
+  GExL::Uint32 theThread)
+{
+  GExL::TAssetHandler<BenchColdAsset>& anHandler =
+    theState.assetManager->GetHandler<BenchColdAsset>();
+  const GExL::Uint32 anIndex = theIndex - theIndex % theState.threadCount + theThread;
+  const GExL::AssetKey& anKey =
+    (*theState.keys)[anIndex < theState.assetCount ? anIndex : theThread];
+  GExL::Uint64 anResult = (GExL::Uint64)(size_t)anHandler.GetReference(anKey);
+  anHandler.DropReference(anKey, GExL::AssetDropAtZero);
+  return anResult;
+}
+
+/// Benchmark name and operation
+struct typeBenchmark
+{
+  const char*        name;      ///< Name written to the results
+  typeBenchOperation operation; ///< Operation to measure
+};
+
+/**
+ * RunThread is responsible for running theOperation OPERATION_COUNT times
+ * in batches and adding the nanoseconds per operation of each batch to
+ * theSamples.
+ */
+void RunThread(typeBenchState& theState, typeBenchOperation theOperation,
+  GExL::Uint32 theThread, std::atomic<GExL::Uint32>& theReady,
+  std::vector<double>& theSamples, GExL::Uint64& theChecksum)
+{
+  // Each thread walks the assets from a different starting point
+  GExL::Uint32 anIndex = (GExL::Uint32)(((GExL::Uint64)theState.assetCount *
+    theThread) / theState.threadCount);
+  GExL::Uint64 anSum = 0;
+  theSamples.reserve(OPERATION_COUNT / BATCH_SIZE);
+
+  // Start every thread at the same time
+  theReady--;
+  while(0 != theReady)
+  {
+    std::this_thread::yield();
+  }
+
+  for(GExL::Uint32 anBatch = 0; anBatch < OPERATION_COUNT / BATCH_SIZE; anBatch++)
+  {
+    const std::chrono::steady_clock::time_point anStart =
+      std::chrono::steady_clock::now();
+    for(GExL::Uint32 anCount = 0; anCount < BATCH_SIZE; anCount++)
+    {
+      anSum += theOperation(theState, anIndex, theThread);
+      if(++anIndex == theState.assetCount)
+      {
+        anIndex = 0;
+      }
+    }
+    theSamples.push_back(std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - anStart).count() / BATCH_SIZE);
+  }
+  theChecksum = anSum;
+}
+
+/**
+ * RunBenchmark is responsible for running theBenchmark on theThreadCount
+ * threads and writing its throughput and latency percentiles as one line
+ * of JSON.
+ */
+void RunBenchmark(typeBenchState& theState, const typeBenchmark& theBenchmark,
+  GExL::Uint32 theThreadCount)
+{
+  theState.threadCount = theThreadCount;
+  std::vector<std::vector<double> > anSamples(theThreadCount);
+  std::vector<GExL::Uint64> anChecksums(theThreadCount, 0);
+  std::atomic<GExL::Uint32> anReady(theThreadCount + 1);
+
+  std::vector<std::thread> anThreads;
+  for(GExL::Uint32 anThread = 0; anThread < theThreadCount; anThread++)
+  {
+    anThreads.push_back(std::thread(RunThread, std::ref(theState),
+      theBenchmark.operation, anThread, std::ref(anReady),
+      std::ref(anSamples[anThread]), std::ref(anChecksums[anThread])));
+  }
+
+  // Time from releasing the threads until the last one is done
+  while(1 != anReady)
+  {
+    std::this_thread::yield();
+  }
+  const std::chrono::steady_clock::time_point anStart =
+    std::chrono::steady_clock::now();
+  anReady--;
+  for(GExL::Uint32 anThread = 0; anThread < theThreadCount; anThread++)
+  {
+    anThreads[anThread].join();
+    theState.checksum += anChecksums[anThread];
+  }
+  const double anSeconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - anStart).count();
+
+  // Gather the latency samples of every thread
+  std::vector<double> anLatencies;
+  for(GExL::Uint32 anThread = 0; anThread < theThreadCount; anThread++)
+  {
+    anLatencies.insert(anLatencies.end(), anSamples[anThread].begin(),
+      anSamples[anThread].end());
+  }
+  std::sort(anLatencies.begin(), anLatencies.end());
+  const size_t anLast = anLatencies.size() - 1;
+  const GExL::Uint64 anOperations = (GExL::Uint64)anLatencies.size() *
+    BATCH_SIZE;
+
+  printf("{\"benchmark\": \"%s\", \"assets\": %u, \"loadedAssets\": %u, "
+    "\"threads\": %u, \"operations\": %llu, \"seconds\": %.6f, "
+    "\"operationsPerSecond\": %.0f, "
+    "\"p50Nanoseconds\": %.2f, \"p90Nanoseconds\": %.2f, "
+    "\"p99Nanoseconds\": %.2f, \"maximumNanoseconds\": %.2f}\n",
+    theBenchmark.name, theState.assetCount, theState.loadedAssets, theThreadCount,
+    (unsigned long long)anOperations, anSeconds,
+    anSeconds > 0.0 ? anOperations / anSeconds : 0.0,
+    anLatencies[anLast * 50 / 100], anLatencies[anLast * 90 / 100],
+    anLatencies[anLast * 99 / 100], anLatencies[anLast]);
+  fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+  if(argc > 3 || (argc > 1 && '-' == argv[1][0]))
+  {
+    fprintf(stderr, "usage: %s [maximum assets] [maximum threads]\n", argv[0]);
+    fprintf(stderr, "Writes one JSON object per line for each benchmark run\n");
+    return 1;
+  }
+
+  // Largest number of assets and most threads to measure
+  GExL::Uint32 anAssetMaximum = (argc > 1) ? (GExL::Uint32)atoi(argv[1]) : 1000000;
+  GExL::Uint32 anThreadMaximum = (argc > 2) ? (GExL::Uint32)atoi(argv[2]) :
+    std::thread::hardware_concurrency();
+  if(0 == anAssetMaximum)
+  {
+    anAssetMaximum = 1000;
+  }
+  if(0 == anThreadMaximum)
+  {
+    anThreadMaximum = 1;
+  }
+
+  // Create the keys of every asset once, the asset ID's are never freed
+  std::vector<GExL::AssetKey> anKeys;
+  anKeys.reserve(anAssetMaximum);
+  for(GExL::Uint32 anIndex = 0; anIndex < anAssetMaximum; anIndex++)
+  {
+    std::ostringstream anID;
+    anID << "asset" << anIndex;
+    anKeys.push_back(GExL::AssetKey(anID.str()));
+  }
+
+  // Every benchmark run for each asset count
+  const typeBenchmark anBenchmarks[] = {
+    { "GetAsset", BenchGetAsset },
+    { "GetHandler", BenchGetHandler },
+    { "GetReference", BenchGetReference },
+    { "CopyAsset", BenchCopyAsset },
+    { "AcquireRelease", BenchAcquireRelease }
+  };
+  const size_t anBenchmarkCount = sizeof(anBenchmarks) / sizeof(anBenchmarks[0]);
+
+  GExL::Uint64 anChecksum = 0;
+  for(GExL::Uint32 anAssetCount = 1000; ; anAssetCount *= 10)
+  {
+    if(anAssetCount > anAssetMaximum)
+    {
+      anAssetCount = anAssetMaximum;
+    }
+
+    // Start with a fresh manager holding anAssetCount loaded assets
+    GExL::AssetManager anAssetManager;
+    anAssetManager.RegisterHandler(new BenchHandler<BenchAsset>());
+    anAssetManager.RegisterHandler(new BenchHandler<BenchColdAsset>());
+
+    typeBenchState anState;
+    anState.assetManager = &anAssetManager;
+    anState.keys = &anKeys;
+    anState.assetCount = anAssetCount;
+    anState.loadedAssets = 0;
+    anState.threadCount = 1;
+    anState.checksum = 0;
+    anState.assets.reserve(anAssetCount);
+    for(GExL::Uint32 anIndex = 0; anIndex < anAssetCount; anIndex++)
+    {
+      anState.assets.push_back(GExL::TAsset<BenchAsset>(anAssetManager,
+        anKeys[anIndex], GExL::AssetLoadNow));
+
+      // Count only assets that were acquired and loaded, not the dummy asset
+      const GExL::TAsset<BenchAsset>& anAsset = anState.assets.back();
+      if(GExL::TAssetHandler<BenchAsset>::INVALID_HANDLE != anAsset.GetHandle() &&
+        anAsset.IsLoaded())
+      {
+        anState.loadedAssets++;
+      }
+    }
+
+    // Timing the dummy asset would make the results meaningless
+    if(anState.loadedAssets != anAssetCount)
+    {
+      fprintf(stderr, "only %u of %u assets were acquired and loaded\n",
+        anState.loadedAssets, anAssetCount);
+      return 1;
+    }
+
+    // Single threaded first and then on every thread
+    for(size_t anBenchmark = 0; anBenchmark < anBenchmarkCount; anBenchmark++)
+    {
+      RunBenchmark(anState, anBenchmarks[anBenchmark], 1);
+      if(1 < anThreadMaximum)
+      {
+        RunBenchmark(anState, anBenchmarks[anBenchmark], anThreadMaximum);
+      }
+    }
+    anChecksum += anState.checksum;
+
+    // Release the warm assets before the manager is deleted
+    anState.assets.clear();
+
+    if(anAssetCount == anAssetMaximum)
+    {
+      break;
+    }
+  }
+
+  fprintf(stderr, "checksum=%llu\n", (unsigned long long)anChecksum);
+  return 0;
+}
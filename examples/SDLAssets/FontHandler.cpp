@@ -30,12 +30,56 @@ bool FontHandler::LoadFromFile(const GExL::typeAssetID theAssetID, Font& theAsse
   }
   return anResult;
 }
-bool FontHandler::LoadFromMemory(const GExL::typeAssetID theAssetID, Font& theAsset)
+bool FontHandler::LoadFromMemory(const GExL::typeAssetID theAssetID,
+  const GExL::AssetSpan& theData, Font& theAsset)
 {
-  return false;
+  bool anResult = false;
+  // SDL_ttf reads the font lazily and theData is only valid during this
+  // call, so the font reads from a copy kept until ReleaseAsset
+  std::vector<GExL::Uint8> anBytes(theData.data, theData.data + theData.size);
+  SDL_RWops* anStream = anBytes.empty() ? NULL :
+    SDL_RWFromConstMem(&anBytes[0], (int)anBytes.size());
+  if (anStream != NULL)
+  {
+    theAsset = TTF_OpenFontRW(anStream, 1, mFontSize);
+    if (theAsset != NULL)
+    {
+      std::lock_guard<std::mutex> anLock(mBufferMutex);
+      mBuffers[theAsset].swap(anBytes);
+      anResult = true;
+    }
+  }
+  if (anResult == false)
+  {
+    ELOG() << "FontHandler::LoadFromMemory(" << theAssetID
+      << ") TTF_Error: " << TTF_GetError() << std::endl;
+  }
+  return anResult;
 }
 
 bool FontHandler::LoadFromNetwork(const GExL::typeAssetID theAssetID, Font& theAsset)
 {
   return false;
+}
+
+void FontHandler::ReleaseAsset(const GExL::typeAssetID theAssetID, Font* theAsset)
+{
+  // Close the font before freeing the bytes it reads from, the bytes are
+  // taken first so a font opened at the same address keeps its own
+  if (*theAsset != NULL)
+  {
+    std::vector<GExL::Uint8> anBytes;
+    {
+      std::lock_guard<std::mutex> anLock(mBufferMutex);
+      std::map<Font, std::vector<GExL::Uint8> >::iterator iter = mBuffers.find(*theAsset);
+      if (iter != mBuffers.end())
+      {
+        anBytes.swap(iter->second);
+        mBuffers.erase(iter);
+      }
+    }
+    TTF_CloseFont(*theAsset);
+    *theAsset = NULL;
+  }
+  GExL::TAssetHandler<Font>::ReleaseAsset(theAssetID, theAsset);
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define FONT_MANGER_HPP_INCLUDED
 #include <GExL/assets/TAssetHandler.hpp>
 #include <SDL_ttf.h>
+#include <map>
+#include <mutex>
+#include <vector>
 typedef TTF_Font* Font;
 class FontHandler : public GExL::TAssetHandler<Font>
 {
@@ -25,14 +28,15 @@ protected:
   */
   virtual bool LoadFromFile(const GExL::typeAssetID theAssetID, Font& theAsset);
   /**
-  * LoadFromMemory is responsible for loading theAsset from memory and
-  * must be defined by the derived class since the interface for TYPE is
-  * unknown at this stage.
+  * LoadFromMemory is responsible for loading theAsset from a copy of
+  * theData kept until theAsset is released, SDL_ttf reads it lazily.
   * @param[in] theAssetID of the asset to be loaded
+  * @param[in] theData read only bytes to load the asset from
   * @param[in] theAsset pointer to load
   * @return true if the asset was successfully loaded, false otherwise
   */
-  virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID, Font& theAsset);
+  virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID,
+    const GExL::AssetSpan& theData, Font& theAsset);
   /**
   * LoadFromNetwork is responsible for loading theAsset from network and
   * must be defined by the derived class since the interface for TYPE is
@@ -42,8 +46,19 @@ protected:
   * @return true if the asset was successfully loaded, false otherwise
   */
   virtual bool LoadFromNetwork(const GExL::typeAssetID theAssetID, Font& theAsset);
+  /**
+  * ReleaseAsset is responsible for closing the font held by theAsset and
+  * freeing the copy of the bytes it was loaded from, if any.
+  * @param[in] theAssetID of the asset to be released
+  * @param[in] theAsset to be released
+  */
+  virtual void ReleaseAsset(const GExL::typeAssetID theAssetID, Font* theAsset);
 private:
   GExL::Uint32 mFontSize;
+  /// Lock protecting the font bytes below, fonts load on the loader threads
+  std::mutex mBufferMutex;
+  /// Bytes each font loaded from memory reads from until it is closed
+  std::map<Font, std::vector<GExL::Uint8> > mBuffers;
 }; // class SurfaceHandler
 
 #endif
\ No newline at end of file
@@ -33,12 +33,56 @@ bool MusicHandler::LoadFromFile(const GExL::typeAssetID theAssetID, Music& theAs
   }
   return anResult;
 }
-bool MusicHandler::LoadFromMemory(const GExL::typeAssetID theAssetID, Music& theAsset)
+bool MusicHandler::LoadFromMemory(const GExL::typeAssetID theAssetID,
+  const GExL::AssetSpan& theData, Music& theAsset)
 {
-  return false;
+  bool anResult = false;
+  // SDL_mixer streams the music and theData is only valid during this
+  // call, so the music streams from a copy kept until ReleaseAsset
+  std::vector<GExL::Uint8> anBytes(theData.data, theData.data + theData.size);
+  SDL_RWops* anStream = anBytes.empty() ? NULL :
+    SDL_RWFromConstMem(&anBytes[0], (int)anBytes.size());
+  if (anStream != NULL)
+  {
+    theAsset = Mix_LoadMUS_RW(anStream, 1);
+  }
+  if (theAsset == NULL)
+  {
+    ELOG() << "MusicHandler::LoadFromMemory(" << theAssetID
+      << ") Mix_Error: " << Mix_GetError() << std::endl;
+  }
+  else
+  {
+    std::lock_guard<std::mutex> anLock(mBufferMutex);
+    mBuffers[theAsset].swap(anBytes);
+    anResult = true;
+  }
+  return anResult;
 }
 
 bool MusicHandler::LoadFromNetwork(const GExL::typeAssetID theAssetID, Music& theAsset)
 {
   return false;
+}
+
+void MusicHandler::ReleaseAsset(const GExL::typeAssetID theAssetID, Music* theAsset)
+{
+  // Free the music before freeing the bytes it streams from, the bytes are
+  // taken first so music loaded at the same address keeps its own
+  if (*theAsset != NULL)
+  {
+    std::vector<GExL::Uint8> anBytes;
+    {
+      std::lock_guard<std::mutex> anLock(mBufferMutex);
+      std::map<Music, std::vector<GExL::Uint8> >::iterator iter = mBuffers.find(*theAsset);
+      if (iter != mBuffers.end())
+      {
+        anBytes.swap(iter->second);
+        mBuffers.erase(iter);
+      }
+    }
+    Mix_FreeMusic(*theAsset);
+    *theAsset = NULL;
+  }
+  GExL::TAssetHandler<Music>::ReleaseAsset(theAssetID, theAsset);
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <GExL/assets/TAssetHandler.hpp>
 #include <SDL.h>
 #include <SDL_mixer.h>
+#include <map>
+#include <mutex>
+#include <vector>
 typedef Mix_Music* Music;
 class MusicHandler : public GExL::TAssetHandler<Music>
 {
@@ -26,14 +29,15 @@ protected:
   */
   virtual bool LoadFromFile(const GExL::typeAssetID theAssetID, Music& theAsset);
   /**
-  * LoadFromMemory is responsible for loading theAsset from memory and
-  * must be defined by the derived class since the interface for TYPE is
-  * unknown at this stage.
+  * LoadFromMemory is responsible for loading theAsset from a copy of
+  * theData kept until theAsset is released, SDL_mixer streams it.
   * @param[in] theAssetID of the asset to be loaded
+  * @param[in] theData read only bytes to load the asset from
   * @param[in] theAsset pointer to load
   * @return true if the asset was successfully loaded, false otherwise
   */
-  virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID, Music& theAsset);
+  virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID,
+    const GExL::AssetSpan& theData, Music& theAsset);
   /**
   * LoadFromNetwork is responsible for loading theAsset from network and
   * must be defined by the derived class since the interface for TYPE is
@@ -43,7 +47,18 @@ protected:
   * @return true if the asset was successfully loaded, false otherwise
   */
   virtual bool LoadFromNetwork(const GExL::typeAssetID theAssetID, Music& theAsset);
+  /**
+  * ReleaseAsset is responsible for freeing the music held by theAsset and
+  * the copy of the bytes it was loaded from, if any.
+  * @param[in] theAssetID of the asset to be released
+  * @param[in] theAsset to be released
+  */
+  virtual void ReleaseAsset(const GExL::typeAssetID theAssetID, Music* theAsset);
 private:
+  /// Lock protecting the music bytes below, music loads on the loader threads
+  std::mutex mBufferMutex;
+  /// Bytes each music loaded from memory streams from until it is freed
+  std::map<Music, std::vector<GExL::Uint8> > mBuffers;
 }; // class TextureHandler
 
 #endif
\ No newline at end of file
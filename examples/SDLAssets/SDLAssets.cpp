@@ -88,6 +88,8 @@ int main(int argc, char** argv)
         gRunning = false;
       }
     }
+    //Finish any textures loaded on the loader threads
+    gAssetManager.Update();
     SDL_RenderClear(gRenderer);
     anBackground.GetAsset().Render();
     SDL_RenderPresent(gRenderer);
@@ -15,31 +15,71 @@ void Texture::RegisterRenderer(SDL_Renderer* theRenderer)
 
 
 
-Texture::Texture() : mTexture(NULL){}
+Texture::Texture() : mTexture(NULL), mSurface(NULL){}
 
 bool Texture::LoadFromFile(std::string theFilename)
 {
 	bool anResult = false;
 	if (theFilename.length() > 0)
 	{
-		SDL_Texture* anTexture = NULL;
+		// Only decode here, the texture is created by Finalize
 		SDL_Surface* anLoadedSurface = IMG_Load(theFilename.c_str());
 		if (anLoadedSurface != NULL)
 		{
 			//Color key image
 			SDL_SetColorKey(anLoadedSurface, SDL_TRUE, SDL_MapRGB(anLoadedSurface->format, 0xFF, 0, 0xFF));
-			anTexture = SDL_CreateTextureFromSurface(Texture::sRenderer, anLoadedSurface);
-			if (anTexture != NULL)
-			{
-				mTexture = anTexture;
-				SDL_FreeSurface(anLoadedSurface);
-				anResult = true;
-			}
+			mSurface = anLoadedSurface;
+			anResult = true;
 		}
 	}
 	return anResult;
 }
 
+bool Texture::LoadFromMemory(const void* theData, GExL::Uint64 theSize)
+{
+	bool anResult = false;
+	// Decode straight from theData, IMG_Load_RW closes the stream for us
+	SDL_RWops* anStream = SDL_RWFromConstMem(theData, (int)theSize);
+	SDL_Surface* anLoadedSurface = (anStream != NULL) ? IMG_Load_RW(anStream, 1) : NULL;
+	if (anLoadedSurface != NULL)
+	{
+		//Color key image
+		SDL_SetColorKey(anLoadedSurface, SDL_TRUE, SDL_MapRGB(anLoadedSurface->format, 0xFF, 0, 0xFF));
+		mSurface = anLoadedSurface;
+		anResult = true;
+	}
+	return anResult;
+}
+
+bool Texture::Finalize(void)
+{
+	bool anResult = false;
+	// The renderer may only be used on the thread that created it
+	if (mSurface != NULL)
+	{
+		SDL_Texture* anTexture = SDL_CreateTextureFromSurface(Texture::sRenderer, mSurface);
+		if (anTexture != NULL)
+		{
+			mTexture = anTexture;
+			anResult = true;
+		}
+		SDL_FreeSurface(mSurface);
+		mSurface = NULL;
+	}
+	return anResult;
+}
+
+GExL::Uint64 Texture::GetMemorySize(void) const
+{
+	int anWidth = 0, anHeight = 0;
+	if (mTexture != NULL)
+	{
+		SDL_QueryTexture(mTexture, NULL, NULL, &anWidth, &anHeight);
+	}
+	// Assume 4 bytes per pixel for the texture memory
+	return (GExL::Uint64)anWidth * anHeight * 4;
+}
+
 void Texture::Render(GExL::Vector2f thePosition, float theRotation, GExL::Vector2f theScale, GExL::IntRect theClipRect, GExL::Vector2f theOrigin, GExL::Color theColor)
 {
 	SDL_Rect anSrcRect, anDstRect;
@@ -8,10 +8,14 @@ class Texture
 public:
 	Texture();
 	bool LoadFromFile(std::string theFilename);
+	bool LoadFromMemory(const void* theData, GExL::Uint64 theSize);
+	bool Finalize(void);
+	GExL::Uint64 GetMemorySize(void) const;
 	void Render(GExL::Vector2f thePosition = GExL::Vector2f(), float theRotation = 0.0f, GExL::Vector2f theScale = GExL::Vector2f(1.0f, 1.0f), GExL::IntRect theClipRect = GExL::IntRect(), GExL::Vector2f theOrigin = GExL::Vector2f(), GExL::Color theColor = GExL::Color());
 	static void RegisterRenderer(SDL_Renderer* theRenderer);
 private:
 	SDL_Texture* mTexture;
+	SDL_Surface* mSurface;
 	static SDL_Renderer* sRenderer;
 };
 
@@ -26,12 +26,41 @@ bool TextureHandler::LoadFromFile(const GExL::typeAssetID theAssetID, Texture& t
   }
   return anResult;
 }
-bool TextureHandler::LoadFromMemory(const GExL::typeAssetID theAssetID, Texture& theAsset)
+bool TextureHandler::LoadFromMemory(const GExL::typeAssetID theAssetID,
+  const GExL::AssetSpan& theData, Texture& theAsset)
 {
-  return false;
+  theAsset = Texture();
+  bool anResult = theAsset.LoadFromMemory(theData.data, theData.size);
+  if (anResult == false)
+  {
+    ELOG() << "TextureHandler::LoadFromMemory(" << theAssetID
+      << ") Unable to decode image!" << std::endl;
+  }
+  return anResult;
 }
 
 bool TextureHandler::LoadFromNetwork(const GExL::typeAssetID theAssetID, Texture& theAsset)
 {
   return false;
+}
+
+GExL::Uint64 TextureHandler::GetAssetSize(const Texture& theAsset) const
+{
+  return theAsset.GetMemorySize();
+}
+
+bool TextureHandler::NeedsFinalize(void) const
+{
+  return true;
+}
+
+bool TextureHandler::FinalizeAsset(const GExL::typeAssetID theAssetID, Texture& theAsset)
+{
+  bool anResult = theAsset.Finalize();
+  if (anResult == false)
+  {
+    ELOG() << "TextureHandler::FinalizeAsset(" << theAssetID
+      << ") Unable to create texture!" << std::endl;
+  }
+  return anResult;
 }
\ No newline at end of file
@@ -24,14 +24,15 @@ protected:
 	*/
 	virtual bool LoadFromFile(const GExL::typeAssetID theAssetID, Texture& theAsset);
 	/**
-	* LoadFromMemory is responsible for loading theAsset from memory and
-	* must be defined by the derived class since the interface for TYPE is
-	* unknown at this stage.
+	* LoadFromMemory is responsible for loading theAsset from theData
+	* provided, the pixels are copied into the texture while loading.
 	* @param[in] theAssetID of the asset to be loaded
+	* @param[in] theData read only bytes to load the asset from
 	* @param[in] theAsset pointer to load
 	* @return true if the asset was successfully loaded, false otherwise
 	*/
-	virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID, Texture& theAsset);
+	virtual bool LoadFromMemory(const GExL::typeAssetID theAssetID,
+		const GExL::AssetSpan& theData, Texture& theAsset);
 	/**
 	* LoadFromNetwork is responsible for loading theAsset from network and
 	* must be defined by the derived class since the interface for TYPE is
@@ -41,6 +42,27 @@ protected:
 	* @return true if the asset was successfully loaded, false otherwise
 	*/
 	virtual bool LoadFromNetwork(const GExL::typeAssetID theAssetID, Texture& theAsset);
+	/**
+	* GetAssetSize returns the number of bytes of texture memory used by
+	* theAsset which is counted against the memory budget.
+	* @param[in] theAsset that was just loaded
+	* @return the number of bytes used by theAsset
+	*/
+	virtual GExL::Uint64 GetAssetSize(const Texture& theAsset) const;
+	/**
+	* NeedsFinalize returns true since textures can only be created on the
+	* thread that owns the renderer, the loader threads only decode images.
+	* @return true so FinalizeAsset is called for each texture loaded
+	*/
+	virtual bool NeedsFinalize(void) const;
+	/**
+	* FinalizeAsset creates the texture from the image decoded by
+	* LoadFromFile or LoadFromMemory on the renderer thread.
+	* @param[in] theAssetID of the asset to finish
+	* @param[in] theAsset that was just decoded
+	* @return true if the texture was created, false otherwise
+	*/
+	virtual bool FinalizeAsset(const GExL::typeAssetID theAssetID, Texture& theAsset);
 private:
 }; // class TextureHandler
 
@@ -8,6 +8,7 @@
 #ifndef   GExL_TYPES_HPP_INCLUDED
 #define   GExL_TYPES_HPP_INCLUDED
 
+#include <functional>
 #include <list>
 #include <map>
 #include <queue>
@@ -54,7 +55,8 @@ namespace GExL
   enum AssetLoadTime
   {
     AssetLoadNow = 0, ///< Load the asset now
-    AssetLoadLater = 1  ///< Load the asset later
+    AssetLoadLater = 1, ///< Load the asset later
+    AssetLoadAsync = 2  ///< Load the asset now on a background loader thread
   };
 
   /// Enumeration of AssetDropTime
@@ -62,7 +64,9 @@ namespace GExL
   {
     AssetDropUnspecified = 0, ///< Drop/unload time unspecified, use default AtZero
     AssetDropAtZero = 1, ///< Drop/unload when count reaches 0
-    AssetDropAtExit = 2  ///< Drop/unload when program exits (deconstructor)
+    AssetDropAtExit = 2, ///< Drop/unload when program exits (deconstructor)
+    AssetDropLRU = 3,    ///< Keep when count reaches 0 until over the memory budget
+    AssetDropDeferred = 4 ///< Queue when count reaches 0, release at a safe point
   };
 
   /// Enumeration of all Asset loading techniques
@@ -74,6 +78,14 @@ namespace GExL
     AssetLoadFromNetwork = 3  ///< Load the asset from the network
   };
 
+  /// Enumeration of Asset load priorities used by the loader threads
+  enum AssetLoadPriority
+  {
+    AssetLoadPrefetch = 0, ///< Might be needed soon, cancelled if unused before it starts
+    AssetLoadVisible = 1, ///< Needed by something being shown (default)
+    AssetLoadCritical = 2  ///< Needed right now, loaded before anything else
+  };
+
 
   /// Declare NameValue typedef which is used for config section maps
   typedef std::map<const std::string, const std::string> typeNameValue;
@@ -88,6 +100,9 @@ namespace GExL
   /// Declare Asset Handler ID typedef which is used for identifying Asset Handler objects
   typedef std::string typeAssetHandlerID;
 
+  /// Declare Asset load callback typedef which is called when an asset load completes
+  typedef std::function<void(const typeAssetID theAssetID, bool theLoaded)> typeAssetLoadCallback;
+
   struct Color
   {
     Color(GExL::Uint32 theR = 255, GExL::Uint32 theG = 255, GExL::Uint32 theB = 255, GExL::Uint32 theA = 0) : r(theR), g(theG), b(theB), a(theA)
@@ -0,0 +1,161 @@
+/**
+ * Provides the AssetGroup class in the GExL namespace which is responsible
+ * for holding the references of a batch of assets loaded together by
+ * AssetManager::LoadGroup.
+ *
+ * @file include/GExL/assets/AssetGroup.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_GROUP_HPP_INCLUDED
+#define   CORE_ASSET_GROUP_HPP_INCLUDED
+
+#include <future>
+#include <string>
+#include <vector>
+#include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
+
+namespace GExL
+{
+  // Forward declare the classes used by each group
+  class AssetManager;
+  class IAssetHandler;
+
+  /// Provides a handle to a batch of assets acquired and released as a unit
+  class GExL_API AssetGroup
+  {
+    public:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Manifest entry describing one asset of a group
+      struct typeManifestEntry {
+        typeAssetHandlerID handlerID; ///< ID of the handler for the asset
+        typeAssetID        assetID;   ///< ID of the asset to load
+        Int32              priority;  ///< Higher priority assets are loaded first
+      };
+
+      /**
+       * AssetGroup constructor, the group is empty until it is given to
+       * AssetManager::LoadGroup.
+       */
+      AssetGroup();
+
+      /**
+       * AssetGroup deconstructor will release every asset still held.
+       */
+      virtual ~AssetGroup();
+
+      /**
+       * GetCount will return the number of assets held by this group.
+       * @return the number of assets in the group
+       */
+      Uint32 GetCount(void) const;
+
+      /**
+       * GetLoadedCount will return the number of assets in this group that
+       * have finished loading successfully, useful for progress bars.
+       * @return the number of assets loaded so far
+       */
+      Uint32 GetLoadedCount(void) const;
+
+      /**
+       * IsDone will return true once every load started for this group has
+       * finished, whether it succeeded or not.
+       * @return true if no load of this group is still in flight
+       */
+      bool IsDone(void) const;
+
+      /**
+       * Wait will block the caller until every load started for this group
+       * has finished. Assets that must be finalized are finalized while
+       * waiting if the caller is the thread that finalizes loads, any other
+       * caller blocks until that thread does (see IAssetHandler::IsFinalizeThread).
+       * @return true if every asset in the group was loaded, false otherwise
+       */
+      bool Wait(void) const;
+
+      /**
+       * Release is responsible for dropping the reference to every asset
+       * held by this group. Loads still in flight finish on their own. The
+       * group must be released before its AssetManager is deleted.
+       */
+      void Release(void);
+
+      /**
+       * ReadManifest is responsible for reading the manifest file theFilename
+       * into theManifest. Each line holds a handler ID, an asset ID and an
+       * optional priority separated by whitespace, lines starting with # are
+       * ignored.
+       * @param[in] theFilename of the manifest to read
+       * @param[out] theManifest to add each entry read to
+       * @return true if the manifest was read, false otherwise
+       */
+      static bool ReadManifest(const std::string& theFilename,
+        std::vector<typeManifestEntry>& theManifest);
+
+    private:
+      // The AssetManager is responsible for filling each group
+      friend class AssetManager;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Asset reference held by the group
+      struct typeGroupAsset {
+        IAssetHandler*            handler;  ///< Handler holding our reference
+        AssetKey                  key;      ///< Key of the asset referenced
+        AssetDropTime             dropTime; ///< Drop time given to DropReference
+        std::shared_future<bool>  future;   ///< Result of the load started
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Assets referenced by this group in the order they were loaded
+      std::vector<typeGroupAsset> mAssets;
+
+      /**
+       * Our copy constructor is private because we do not allow copies of our
+       * class
+       */
+      AssetGroup(const AssetGroup&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies of our
+       * class
+       */
+      AssetGroup& operator=(const AssetGroup&); // Intentionally undefined
+  }; // class AssetGroup
+} // namespace GExL
+
+#endif // CORE_ASSET_GROUP_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetGroup
+ * @ingroup Core
+ * The AssetGroup class is the handle returned by AssetManager::LoadGroup for
+ * a level or scene worth of assets. The manager acquires every asset in the
+ * manifest, sorts them by priority and then by where their bytes live on disk
+ * and starts all of the loads on the loader threads at once. The group keeps
+ * one reference to each asset until Release is called or the group is
+ * deleted, so a level transition is a single LoadGroup for the new level
+ * followed by a Release of the old group.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
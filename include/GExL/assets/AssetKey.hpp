@@ -0,0 +1,194 @@
+/**
+ * Provides the AssetKey class in the GExL namespace which is an interned 64
+ * bit handle for an asset ID string.
+ *
+ * @file include/GExL/assets/AssetKey.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_KEY_HPP_INCLUDED
+#define   CORE_ASSET_KEY_HPP_INCLUDED
+
+#include <ostream>
+#include <GExL/GExL_types.hpp>
+
+namespace GExL
+{
+  /**
+   * HashAssetID will return the 64 bit FNV-1a hash of theAssetID provided.
+   * This is a constexpr function so literal asset ID's can be hashed at
+   * compile time, e.g. switch(key.GetHash()) { case HashAssetID("hero"): }
+   * @param[in] theAssetID null terminated asset ID to hash
+   * @param[in] theHash to continue hashing from (leave as the default)
+   * @return the 64 bit hash of theAssetID
+   */
+  constexpr Uint64 HashAssetID(const char* theAssetID,
+    Uint64 theHash = 14695981039346656037ULL)
+  {
+    return (0 == *theAssetID) ? theHash :
+      HashAssetID(theAssetID + 1, (theHash ^ (Uint8)*theAssetID) * 1099511628211ULL);
+  }
+
+  /**
+   * HashAssetData will return a 64 bit hash of theSize bytes at theData
+   * provided, used to find assets whose source bytes are identical (see
+   * IAssetHandler::SetContentSharing). It reads 8 bytes per step so large
+   * files are hashed much faster than with HashAssetID, but it is not a
+   * cryptographic hash.
+   * @param[in] theData to hash
+   * @param[in] theSize in bytes of theData
+   * @return the 64 bit hash of theData
+   */
+  Uint64 GExL_API HashAssetData(const void* theData, Uint64 theSize);
+
+  /// Provides an interned 64 bit handle for each asset ID string
+  class GExL_API AssetKey
+  {
+    public:
+      /**
+       * AssetKey default constructor creates the key for the empty asset ID.
+       */
+      AssetKey();
+
+      /**
+       * AssetKey constructor will hash and intern theAssetID provided so
+       * every AssetKey for the same ID shares a single copy of the string.
+       * @param[in] theAssetID to create the key for
+       */
+      AssetKey(const typeAssetID& theAssetID);
+
+      /**
+       * AssetKey constructor will hash and intern theAssetID provided so
+       * every AssetKey for the same ID shares a single copy of the string.
+       * @param[in] theAssetID null terminated asset ID to create the key for
+       */
+      AssetKey(const char* theAssetID);
+
+      /**
+       * AssetKey constructor will find the asset ID previously interned under
+       * theHash provided (see HashAssetID). A warning is logged and the empty
+       * asset ID used if theHash has never been interned.
+       * @param[in] theHash of an asset ID that was previously interned
+       */
+      explicit AssetKey(Uint64 theHash);
+
+      /**
+       * GetHash will return the 64 bit hash of the asset ID. This is the
+       * HashAssetID of the asset ID unless another asset ID with the same
+       * hash was interned first, in which case a different hash unique to
+       * this asset ID is used (see Intern).
+       * @return the 64 bit hash of the asset ID
+       */
+      Uint64 GetHash(void) const
+      {
+        return mHash;
+      }
+
+      /**
+       * GetID will return the interned asset ID string.
+       * @return the asset ID this key was created for
+       */
+      const typeAssetID& GetID(void) const
+      {
+        return *mAssetID;
+      }
+
+      /**
+       * Equal operator only compares the hash of each key, which is unique
+       * to each asset ID interned (see GetHash).
+       * @param[in] theRight hand side of the == operation
+       * @return true if both keys are for the same asset ID
+       */
+      bool operator==(const AssetKey& theRight) const
+      {
+        return mHash == theRight.mHash;
+      }
+
+      /**
+       * Not equal operator only compares the hash of each key.
+       * @param[in] theRight hand side of the != operation
+       * @return true if the keys are for different asset ID's
+       */
+      bool operator!=(const AssetKey& theRight) const
+      {
+        return mHash != theRight.mHash;
+      }
+
+      /**
+       * Less than operator orders keys by their hash so AssetKey can be used
+       * with std::map and std::sort.
+       * @param[in] theRight hand side of the < operation
+       * @return true if this hash is less than theRight hash
+       */
+      bool operator<(const AssetKey& theRight) const
+      {
+        return mHash < theRight.mHash;
+      }
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// 64 bit FNV-1a hash of the asset ID, unique to the asset ID
+      Uint64             mHash;
+      /// Interned asset ID string which lives until the application exits
+      const typeAssetID* mAssetID;
+
+      /**
+       * Intern is responsible for returning the single shared copy of
+       * theAssetID stored under theHash, adding it if necessary. If another
+       * asset ID is already stored under theHash, the hash is mixed again
+       * until the hash holding theAssetID or an unused hash is found, so
+       * two asset ID's never share a key.
+       * @param[in,out] theHash of theAssetID, changed on a collision
+       * @param[in] theAssetID to intern
+       * @return the interned copy of theAssetID
+       */
+      static const typeAssetID* Intern(Uint64& theHash, const char* theAssetID);
+  }; // class AssetKey
+
+  /**
+   * Stream operator writes the asset ID of theAssetKey so keys can be
+   * logged the same way asset ID strings are.
+   * @param[in] theStream to write to
+   * @param[in] theAssetKey to write
+   * @return theStream provided
+   */
+  inline std::ostream& operator<<(std::ostream& theStream, const AssetKey& theAssetKey)
+  {
+    return theStream << theAssetKey.GetID();
+  }
+} // namespace GExL
+
+#endif // CORE_ASSET_KEY_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetKey
+ * @ingroup Core
+ * The AssetKey class is used by TAssetHandler and TAsset to identify assets
+ * by a 64 bit hash instead of comparing asset ID strings. Each asset ID
+ * string is interned once in a global string table the first time a key is
+ * created for it, so copying a key or looking an asset up never allocates or
+ * compares strings. An asset ID whose hash collides with an asset ID
+ * interned before it is given the next free hash of a fixed sequence, so
+ * each asset ID still has its own key. Such an asset ID no longer matches
+ * its HashAssetID value or asset pack entry and an error is logged.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,169 @@
+/**
+ * Provides the AssetLoader class in the GExL namespace which is responsible
+ * for running asset loading tasks on a pool of background threads.
+ *
+ * @file include/GExL/assets/AssetLoader.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_LOADER_HPP_INCLUDED
+#define   CORE_ASSET_LOADER_HPP_INCLUDED
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <GExL/GExL_types.hpp>
+
+namespace GExL
+{
+  /// Provides a pool of background threads for loading assets
+  class GExL_API AssetLoader
+  {
+    public:
+      /// Declare the loading task typedef which is run by each loader thread
+      typedef std::function<void(void)> typeLoadTask;
+
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of AssetLoadPriority values, one task queue for each
+      static const Uint32 PRIORITY_COUNT = AssetLoadCritical + 1;
+
+      /**
+       * AssetLoader constructor, no threads are started until Start or
+       * AddTask is called.
+       */
+      AssetLoader();
+
+      /**
+       * AssetLoader deconstructor will finish all queued tasks and stop
+       * every loader thread.
+       */
+      virtual ~AssetLoader();
+
+      /**
+       * Start is responsible for starting theThreadCount loader threads if
+       * the loader is not already running.
+       * @param[in] theThreadCount to start or 0 to pick one per spare CPU core
+       */
+      void Start(Uint32 theThreadCount = 0);
+
+      /**
+       * Stop is responsible for finishing every queued task and then joining
+       * all of the loader threads.
+       */
+      void Stop(void);
+
+      /**
+       * IsRunning will return true if the loader threads have been started.
+       * @return true if running, false otherwise
+       */
+      bool IsRunning(void) const;
+
+      /**
+       * GetThreadCount will return the number of loader threads running.
+       * @return the number of loader threads
+       */
+      Uint32 GetThreadCount(void) const;
+
+      /**
+       * AddTask is responsible for queuing theTask to be run by the next
+       * available loader thread. Tasks with a higher thePriority are always
+       * run first, tasks with the same priority are run in the order they
+       * were added. The loader threads are started with the default thread
+       * count if they are not yet running.
+       * @param[in] theTask to be run on a loader thread
+       * @param[in] thePriority (Prefetch, Visible, Critical) of theTask
+       */
+      void AddTask(typeLoadTask theTask,
+        AssetLoadPriority thePriority = AssetLoadVisible);
+
+      /**
+       * WaitForIdle will block the caller until every queued task has been
+       * run and no loader thread is busy.
+       */
+      void WaitForIdle(void);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Loader threads that run the queued tasks
+      std::vector<std::thread> mThreads;
+      /// Tasks waiting for a loader thread for each AssetLoadPriority
+      std::deque<typeLoadTask> mTasks[PRIORITY_COUNT];
+      /// Lock protecting every variable below
+      mutable std::mutex mMutex;
+      /// Condition used to wake up the loader threads
+      std::condition_variable mTaskCondition;
+      /// Condition used to wake up callers of WaitForIdle
+      std::condition_variable mIdleCondition;
+      /// Number of loader threads currently running a task
+      Uint32 mBusy;
+      /// True while the loader threads should keep waiting for tasks
+      bool mRunning;
+
+      /**
+       * PopTask is responsible for taking the oldest task with the highest
+       * priority from the queues. mMutex must be held by the caller.
+       * @param[out] theTask taken from the queues
+       * @return true if a task was taken, false if every queue is empty
+       */
+      bool PopTask(typeLoadTask& theTask);
+
+      /**
+       * IsEmpty will return true if no task is waiting in any queue.
+       * mMutex must be held by the caller.
+       * @return true if every queue is empty, false otherwise
+       */
+      bool IsEmpty(void) const;
+
+      /**
+       * Run is the loop each loader thread executes until Stop is called.
+       */
+      void Run(void);
+
+      /**
+       * Our copy constructor is private because we do not allow copies of our
+       * class
+       */
+      AssetLoader(const AssetLoader&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies of our
+       * class
+       */
+      AssetLoader& operator=(const AssetLoader&); // Intentionally undefined
+  }; // class AssetLoader
+} // namespace GExL
+
+#endif // CORE_ASSET_LOADER_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetLoader
+ * @ingroup Core
+ * The AssetLoader class is owned by the AssetManager and is used by each
+ * TAssetHandler to load AssetLoadAsync assets off of the calling thread.
+ * Tasks are run highest AssetLoadPriority first and in the order they were
+ * added within each priority by however many threads were started.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
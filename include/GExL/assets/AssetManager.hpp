@@ -10,8 +10,16 @@
 #ifndef   CORE_ASSET_MANAGER_HPP_INCLUDED
 #define   CORE_ASSET_MANAGER_HPP_INCLUDED
 
+#include <atomic>
 #include <map>
+#include <ostream>
+#include <thread>
 #include <typeinfo>
+#include <vector>
+#include <GExL/assets/AssetGroup.hpp>
+#include <GExL/assets/AssetLoader.hpp>
+#include <GExL/assets/AssetPack.hpp>
+#include <GExL/assets/AssetWatcher.hpp>
 #include <GExL/assets/TAssetHandler.hpp>
 #include <GExL/GExL_types.hpp>
 
@@ -33,9 +41,10 @@ namespace GExL
 
       /**
        * GetHandler is responsible for returning an TAssetHandler derived
-       * class that was previously registered under typeid(TYPE).name() of the
-       * TYPE provided which can then be used to obtain Asset references by
-       * Asset ID.
+       * class that was previously registered for the TYPE provided which can
+       * then be used to obtain Asset references by Asset ID. The handler is
+       * found by indexing a flat array with the type index of TYPE (see
+       * IAssetHandler::GetTypeIndex) so no strings are compared or allocated.
        * @return TAssetHandler<TYPE> reference class for asset TYPE specified
        */
       template<class TYPE>
@@ -44,17 +53,13 @@ namespace GExL
         // The TAssetHandler<TYPE> derived class that will be returned
         TAssetHandler<TYPE>* anResult = NULL;
 
-        // Iterator to the asset if found
-        std::map<const typeAssetHandlerID, IAssetHandler*>::const_iterator iter;
+        // The type index that TYPE was registered under
+        const Uint32 anTypeIndex = IAssetHandler::GetTypeIndex<TYPE>();
 
-        // Try to find the asset using theAssetID as the key
-        iter = mHandlers.find(typeid(TYPE).name());
-
-        // Found asset? increment the count and return the reference
-        if(iter != mHandlers.end())
+        // Found handler? cast the IAssetHandler address found into TAssetHandler
+        if(anTypeIndex < mTypeHandlers.size())
         {
-          // Cast the IAssetHandler address found into TAssetHandler
-          anResult = static_cast<TAssetHandler<TYPE>*>(iter->second);
+          anResult = static_cast<TAssetHandler<TYPE>*>(mTypeHandlers[anTypeIndex]);
         }
 
         // Make sure we aren't returning NULL at this point
@@ -77,10 +82,21 @@ namespace GExL
        */
       IAssetHandler& GetHandler(const typeAssetHandlerID theAssetHandlerID) const;
 
+      /**
+       * FindHandler is responsible for returning the IAssetHandler derived
+       * class registered under theAssetHandlerID provided, or NULL instead
+       * of failing if no handler was registered under it.
+       * @param[in] theAssetHandlerID to find
+       * @return IAssetHandler pointer or NULL if not found
+       */
+      IAssetHandler* FindHandler(const typeAssetHandlerID theAssetHandlerID) const;
+
       /**
        * RegisterHandler is responsible for registering an IAssetHandler
        * derived class with the AssetManager. These handlers are used to manage
-       * various asset types used by game states and other entities.
+       * various asset types used by game states and other entities. Every
+       * handler should be registered before GetHandler is called from more
+       * than one thread.
        * @param[in] theAssetHandler pointer to register
        */
       void RegisterHandler(IAssetHandler* theAssetHandler);
@@ -88,19 +104,238 @@ namespace GExL
       /**
        * LoadAllAssets is responsible for loading all unloaded assets for every
        * IAssetHandler derived class registered, typically from the
-       * IState::DoInit() method.
+       * IState::DoInit() method. If theParallel is true every asset of every
+       * handler is loaded on the loader threads at once while the calling
+       * thread finalizes the assets that must be finished on it (see
+       * IAssetHandler::FinalizeLoads), dependencies first (see LoadGraph),
+       * then the speedup is logged as the time spent inside every load
+       * divided by the time taken, which overstates it when there are more
+       * loader threads than free cores.
+       * @param[in] theParallel true to load on the loader threads
        * @return true if all assets load successfully, false otherwise
        */
-      bool LoadAllAssets(void);
+      bool LoadAllAssets(bool theParallel = false);
+
+      /**
+       * LoadGraph is responsible for loading theAssets and every asset they
+       * depend on (see IAssetHandler::AddDependency) on the loader threads
+       * in topological order. Every asset whose dependencies are loaded is
+       * started at once, so independent branches load in parallel, and each
+       * asset is started as soon as its last dependency finishes. Dependencies
+       * added while an asset loads are loaded right after it. If the calling
+       * thread finalizes loads it finishes the assets that must be finalized
+       * while it waits, otherwise it waits for Update (see IsFinalizeThread).
+       * An asset is still loaded
+       * if one of its dependencies failed to load.
+       * @param[in] theAssets to load along with their dependencies
+       * @return true if every asset was loaded, false otherwise
+       */
+      bool LoadGraph(const std::vector<IAssetHandler::typeAssetDependency>& theAssets);
+
+      /**
+       * LoadPendingAssets is responsible for loading unloaded AssetLoadLater
+       * assets of every registered handler on the calling thread until
+       * theBudget microseconds have passed, measured with the steady clock.
+       * Call this once per frame to spread loading over a running loop, each
+       * call continues where the previous one stopped. A load that has
+       * started is never interrupted so the budget may be overrun by up to
+       * one load.
+       * @param[in] theBudget in microseconds to spend loading assets
+       * @return the number of AssetLoadLater assets still waiting to be loaded
+       */
+      Uint32 LoadPendingAssets(Uint32 theBudget);
+
+      /**
+       * ReleaseDeferredAssets is responsible for releasing the unused
+       * AssetDropDeferred assets of every registered handler, oldest first,
+       * on the calling thread until theBudget microseconds have passed. Update
+       * calls this with the release budget, call it yourself to release them
+       * at another safe point or from a thread of your own if every handler
+       * may release its assets on any thread.
+       * @param[in] theBudget in microseconds to spend releasing assets
+       * @return the number of AssetDropDeferred assets still waiting
+       */
+      Uint32 ReleaseDeferredAssets(Uint32 theBudget);
+
+      /**
+       * SetReleaseBudget sets the number of microseconds Update may spend
+       * releasing unused AssetDropDeferred assets (see ReleaseDeferredAssets).
+       * A budget of 0 leaves releasing them to the caller.
+       * @param[in] theBudget in microseconds for each Update
+       */
+      void SetReleaseBudget(Uint32 theBudget);
+
+      /**
+       * GetReleaseBudget returns the release budget set by SetReleaseBudget.
+       * @return the release budget in microseconds
+       */
+      Uint32 GetReleaseBudget(void) const;
+
+      /**
+       * LoadGroup is responsible for acquiring every asset listed in
+       * theManifest into theGroup and loading them together on the loader
+       * threads. Assets are started highest priority first and then in the
+       * order their bytes are stored, by pack offset for assets found in a
+       * mounted pack or by filename otherwise, so the reads stay close
+       * together. A manifest priority below 0 loads the asset as
+       * AssetLoadPrefetch, 0 as AssetLoadVisible and above 0 as
+       * AssetLoadCritical. Any assets already held by theGroup are released
+       * first.
+       * @param[in] theManifest of assets to load (see AssetGroup::ReadManifest)
+       * @param[out] theGroup to hold a reference to each asset
+       * @param[in] theLoadStyle (File, Mem, Network) to use for new assets
+       * @param[in] theDropTime indicates if assets are dropped when count = 0 or exit
+       * @return true if every asset was acquired, false otherwise
+       */
+      bool LoadGroup(const std::vector<AssetGroup::typeManifestEntry>& theManifest,
+        AssetGroup& theGroup, AssetLoadStyle theLoadStyle = AssetLoadFromFile,
+        AssetDropTime theDropTime = AssetDropAtZero);
+
+      /**
+       * GetLoader will return the AssetLoader used by every registered
+       * IAssetHandler to load AssetLoadAsync assets on background threads.
+       * Call GetLoader().Start(count) to choose the number of loader threads,
+       * otherwise they will be started on demand.
+       * @return AssetLoader reference owned by this AssetManager
+       */
+      AssetLoader& GetLoader(void);
+
+      /**
+       * IsFinalizeThread will return true if the calling thread created this
+       * AssetManager, the only thread that finalizes loads for the registered
+       * handlers (see IAssetHandler::FinalizeLoads). Other threads waiting
+       * for a load block until that thread finalizes it.
+       * @return true if the calling thread finalizes loads, false otherwise
+       */
+      bool IsFinalizeThread(void) const;
+
+      /**
+       * SetMemoryBudget sets the number of bytes every registered handler
+       * may keep resident together before unused AssetDropLRU assets are
+       * released. Each handler may also have its own budget (see
+       * IAssetHandler::SetMemoryBudget). A budget of 0 (default) means there
+       * is no global limit.
+       * @param[in] theBytes all handlers may keep resident or 0 for no limit
+       */
+      void SetMemoryBudget(Uint64 theBytes);
+
+      /**
+       * GetMemoryBudget returns the global memory budget.
+       * @return the global memory budget in bytes or 0 if there is no limit
+       */
+      Uint64 GetMemoryBudget(void) const;
+
+      /**
+       * GetResidentBytes returns the number of bytes used by the loaded
+       * assets of every registered handler.
+       * @return the number of bytes currently resident
+       */
+      Uint64 GetResidentBytes(void) const;
+
+      /**
+       * CheckMemoryBudget is responsible for trimming the unused AssetDropLRU
+       * assets of each registered handler in turn until the resident bytes
+       * fit in the global memory budget again. Handlers call this after
+       * assets are loaded or become unused.
+       */
+      void CheckMemoryBudget(void);
+
+      /**
+       * WriteStats is responsible for writing the statistics of every
+       * registered handler (see IAssetHandler::GetStats) to theStream as a
+       * JSON object, along with the global memory budget and resident bytes.
+       * Load times are in nanoseconds.
+       * @param[in] theStream to write the JSON object to
+       */
+      void WriteStats(std::ostream& theStream) const;
+
+      /**
+       * MountPack is responsible for memory mapping the asset pack file
+       * theFilename provided (see AssetPack) so handlers can load assets
+       * straight from the mapping using IAssetHandler::GetPackData. Packs
+       * mounted later take priority over packs mounted earlier. Every pack
+       * should be mounted before assets are loaded from more than one thread.
+       * @param[in] theFilename of the asset pack to mount
+       * @return true if the pack was mounted, false otherwise
+       */
+      bool MountPack(const std::string& theFilename);
+
+      /**
+       * FindPackData is responsible for finding the bytes of theAssetID in
+       * the mounted asset packs, newest pack first. Raw assets are not copied
+       * and theSpan stays valid until this AssetManager is deleted, compressed
+       * assets are decompressed into theBuffer (see AssetPack::Find).
+       * @param[in] theAssetID to find
+       * @param[out] theSpan of the asset bytes if found
+       * @param[out] theBuffer to decompress compressed assets into
+       * @return true if theAssetID was found in a mounted pack, false otherwise
+       */
+      bool FindPackData(const AssetKey& theAssetID, AssetSpan& theSpan,
+        std::vector<Uint8>& theBuffer) const;
+
+      /**
+       * WatchDirectory is responsible for watching theDirectory and every
+       * directory below it for files that change on disk so the assets
+       * loaded from them are reloaded by Update. Changed files are reported
+       * as theDirectory + "/" + the path below it, which must match the
+       * filename used to load each asset (see IAssetHandler::GetFilename).
+       * @param[in] theDirectory to watch
+       * @return true if theDirectory is being watched, false otherwise
+       */
+      bool WatchDirectory(const std::string& theDirectory);
+
+      /**
+       * ReloadFile is responsible for asking every registered handler to
+       * reload the assets loaded from theFilename provided on the loader
+       * threads. The reloaded assets are swapped in by the next Update.
+       * @param[in] theFilename that changed
+       * @return the number of assets being reloaded or released
+       */
+      Uint32 ReloadFile(const std::string& theFilename);
+
+      /**
+       * Update is responsible for finalizing every asset loaded on the loader
+       * threads, swapping in every asset reloaded since the last call,
+       * releasing unused AssetDropDeferred assets within the release budget
+       * and starting the reload of any watched file that changed.
+       * Call this once per frame from the thread that created this
+       * AssetManager (see IsFinalizeThread), at a point where no other thread
+       * is reading the assets.
+       */
+      void Update(void);
 
     private:
       // Constants
       ///////////////////////////////////////////////////////////////////////////
+      /// Default microseconds Update may spend releasing deferred assets
+      static const Uint32 RELEASE_BUDGET = 1000;
 
       // Variables
       ///////////////////////////////////////////////////////////////////////////
       /// Map to hold all IAssetHandler derived classes that manage assets
       std::map<const typeAssetHandlerID, IAssetHandler*> mHandlers;
+      /// Flat array of IAssetHandler derived classes indexed by type index
+      std::vector<IAssetHandler*> mTypeHandlers;
+      /// Background loader threads used for AssetLoadAsync assets
+      AssetLoader mLoader;
+      /// Number of bytes all handlers may keep resident or 0 for no limit
+      std::atomic<Uint64> mMemoryBudget;
+      /// Microseconds Update may spend releasing AssetDropDeferred assets
+      std::atomic<Uint32> mReleaseBudget;
+      /// Asset packs mounted by MountPack in the order they were mounted
+      std::vector<AssetPack*> mPacks;
+      /// Watcher thread collecting files changed on disk
+      AssetWatcher mWatcher;
+      /// Thread that created this AssetManager and finalizes loads
+      const std::thread::id mFinalizeThread;
+
+      /**
+       * LocatePackData is responsible for finding where theAssetID is stored
+       * in the mounted asset packs, newest pack first, without decompressing.
+       * @param[in] theAssetID to find
+       * @return the first stored byte of theAssetID or NULL if not found
+       */
+      const Uint8* LocatePackData(const AssetKey& theAssetID) const;
 
       /**
        * AssetManager copy constructor is private because we do not allow copies
@@ -0,0 +1,239 @@
+/**
+ * Provides the AssetPack class in the GExL namespace which is responsible
+ * for memory mapping a GExL asset pack file and finding the data of each
+ * asset stored in it.
+ *
+ * @file include/GExL/assets/AssetPack.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_PACK_HPP_INCLUDED
+#define   CORE_ASSET_PACK_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
+
+namespace GExL
+{
+  /// Provides a read only view of bytes owned by someone else
+  struct AssetSpan
+  {
+    AssetSpan(const Uint8* theData = NULL, Uint64 theSize = 0) :
+      data(theData), size(theSize)
+    {}
+    const Uint8* data; ///< First byte of the span or NULL if empty
+    Uint64       size; ///< Number of bytes in the span
+  };
+
+  /// Provides a memory mapped reader for GExL asset pack files
+  class GExL_API AssetPack
+  {
+    public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Current version of the asset pack file format
+      static const Uint32 PACK_VERSION = 1;
+      /// Default alignment of each asset blob in the pack file
+      static const Uint32 PACK_ALIGNMENT = 16;
+      /// Storage flag for asset blobs compressed with AssetPack::Compress
+      static const Uint32 ENTRY_COMPRESSED = 1;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Header found at the start of every asset pack file (little endian)
+      struct typePackHeader {
+        char   magic[8];  ///< Always "GEXLPACK"
+        Uint32 version;   ///< File format version (PACK_VERSION)
+        Uint32 count;     ///< Number of entries in the table of contents
+        Uint64 tocOffset; ///< Offset of the table of contents (8 byte aligned)
+        Uint32 alignment; ///< Alignment of each asset blob
+        Uint32 flags;     ///< Reserved, always 0
+      };
+
+      /// Table of contents entry for each asset, sorted by hash (little endian)
+      struct typePackEntry {
+        Uint64 hash;       ///< HashAssetID of the asset ID
+        Uint64 offset;     ///< Offset of the asset blob from the start of the file
+        Uint64 storedSize; ///< Number of bytes stored in the pack for this asset
+        Uint64 size;       ///< Number of bytes of the asset itself
+        Uint32 flags;      ///< Storage flags, 0 for raw bytes or ENTRY_COMPRESSED
+        Uint32 reserved;   ///< Reserved, always 0
+      };
+
+      /**
+       * AssetPack constructor, no file is mapped until Open is called.
+       */
+      AssetPack();
+
+      /**
+       * AssetPack deconstructor will unmap the pack file if it is open.
+       */
+      virtual ~AssetPack();
+
+      /**
+       * Open is responsible for memory mapping theFilename provided and
+       * checking that its header and table of contents are valid. Packs
+       * with an entry outside the file, a raw entry whose size differs from
+       * its stored size, a compressed entry larger than Compress could have
+       * produced from its stored size or unknown storage flags are rejected.
+       * @param[in] theFilename of the asset pack to open
+       * @return true if the pack was opened, false otherwise
+       */
+      bool Open(const std::string& theFilename);
+
+      /**
+       * Close will unmap the pack file. Every AssetSpan previously returned
+       * by Find becomes invalid.
+       */
+      void Close(void);
+
+      /**
+       * IsOpen will return true if a pack file is currently mapped.
+       * @return true if open, false otherwise
+       */
+      bool IsOpen(void) const;
+
+      /**
+       * GetFilename will return the filename of the pack that was opened.
+       * @return the filename provided to Open
+       */
+      const std::string& GetFilename(void) const;
+
+      /**
+       * GetCount will return the number of assets stored in the pack.
+       * @return the number of table of contents entries
+       */
+      Uint32 GetCount(void) const;
+
+      /**
+       * Find is responsible for finding theAssetID in the table of contents
+       * and returning a span of its bytes. Raw assets are handed out straight
+       * from the mapping without copying and the span stays valid until Close
+       * is called. Compressed assets are decompressed into theBuffer owned by
+       * the caller and the span stays valid as long as theBuffer is unchanged.
+       * @param[in] theAssetID to find
+       * @param[out] theSpan of the asset bytes if found
+       * @param[out] theBuffer to decompress compressed assets into
+       * @return true if theAssetID was found, false otherwise
+       */
+      bool Find(const AssetKey& theAssetID, AssetSpan& theSpan,
+        std::vector<Uint8>& theBuffer) const;
+
+      /**
+       * Locate is responsible for finding where theAssetID is stored in the
+       * mapping without decompressing it, used to order loads by storage.
+       * @param[in] theAssetID to find
+       * @return the first stored byte of theAssetID or NULL if not found
+       */
+      const Uint8* Locate(const AssetKey& theAssetID) const;
+
+      /**
+       * Compress is responsible for compressing theSize bytes at theData
+       * into theResult using the LZ77 byte format understood by Decompress.
+       * Used by the gexl-pack tool for ENTRY_COMPRESSED asset blobs.
+       * @param[in] theData to compress
+       * @param[in] theSize number of bytes at theData
+       * @param[out] theResult to hold the compressed bytes
+       */
+      static void Compress(const Uint8* theData, Uint64 theSize,
+        std::vector<Uint8>& theResult);
+
+      /**
+       * Decompress is responsible for decompressing theSize bytes at
+       * theData produced by Compress into exactly theResultSize bytes at
+       * theResult. Every read and write is bounds checked.
+       * @param[in] theData to decompress
+       * @param[in] theSize number of bytes at theData
+       * @param[out] theResult to write the decompressed bytes to
+       * @param[in] theResultSize number of bytes expected at theResult
+       * @return true if exactly theResultSize bytes were decompressed
+       */
+      static bool Decompress(const Uint8* theData, Uint64 theSize,
+        Uint8* theResult, Uint64 theResultSize);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Filename of the pack file that was opened
+      std::string          mFilename;
+      /// First byte of the memory mapped pack file
+      const Uint8*         mData;
+      /// Number of bytes mapped
+      Uint64               mSize;
+      /// Table of contents found in the mapping
+      const typePackEntry* mEntries;
+      /// Number of table of contents entries
+      Uint32               mCount;
+#if defined(GExL_WINDOWS)
+      /// Windows file handle of the pack file
+      void*                mFile;
+      /// Windows file mapping handle of the pack file
+      void*                mMapping;
+#endif
+
+      /**
+       * GetEntry is responsible for returning the table of contents entry at
+       * theIndex converted to the byte order of this machine.
+       * @param[in] theIndex of the entry to return
+       * @return the entry at theIndex
+       */
+      typePackEntry GetEntry(Uint32 theIndex) const;
+
+      /**
+       * FindEntry is responsible for binary searching the table of contents
+       * for theAssetID and returning its entry.
+       * @param[in] theAssetID to find
+       * @param[out] theEntry found for theAssetID
+       * @return true if theAssetID was found, false otherwise
+       */
+      bool FindEntry(const AssetKey& theAssetID, typePackEntry& theEntry) const;
+
+      /**
+       * Our copy constructor is private because we do not allow copies of our
+       * class
+       */
+      AssetPack(const AssetPack&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies of our
+       * class
+       */
+      AssetPack& operator=(const AssetPack&); // Intentionally undefined
+  }; // class AssetPack
+} // namespace GExL
+
+#endif // CORE_ASSET_PACK_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetPack
+ * @ingroup Core
+ * The AssetPack class maps a single GExL asset pack file into memory. A pack
+ * starts with a typePackHeader, followed by each asset blob aligned to the
+ * alignment given in the header and finally a table of contents of
+ * typePackEntry structures sorted by the HashAssetID of each asset ID. Find
+ * uses a binary search of the table of contents and hands out spans that
+ * point straight into the mapping so handlers can load assets from memory
+ * without any file reads. Pack files are written by the gexl-pack tool and
+ * mounted with AssetManager::MountPack.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,231 @@
+/**
+ * Provides the AssetTrace class in the GExL namespace which is responsible
+ * for recording asset load timelines that can be viewed in chrome://tracing
+ * or Perfetto.
+ *
+ * @file include/GExL/assets/AssetTrace.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_TRACE_HPP_INCLUDED
+#define   CORE_ASSET_TRACE_HPP_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
+
+namespace GExL
+{
+  /// Provides a recorder of begin and end events for each thread
+  class GExL_API AssetTrace
+  {
+    public:
+      /// Default number of events each thread can record
+      static const Uint32 EVENT_CAPACITY = 65536;
+
+      /// Provides a begin event that is ended when it goes out of scope
+      class Scope
+      {
+        public:
+          /**
+           * Scope constructor will record a begin event for theName and
+           * theCategory provided if the trace is recording.
+           * @param[in] theName of the event, must outlive the trace
+           * @param[in] theCategory of the event, must outlive the trace
+           */
+          Scope(const char* theName, const char* theCategory) :
+            mBegun(AssetTrace::Begin(theName, theCategory))
+          {
+          }
+
+          /**
+           * Scope constructor will record a begin event for theName,
+           * theCategory and theAssetID provided if the trace is recording.
+           * @param[in] theName of the event, must outlive the trace
+           * @param[in] theCategory of the event, must outlive the trace
+           * @param[in] theAssetID the event is for
+           */
+          Scope(const char* theName, const char* theCategory,
+            const AssetKey& theAssetID) :
+            mBegun(AssetTrace::Begin(theName, theCategory, theAssetID))
+          {
+          }
+
+          /**
+           * Scope deconstructor will record the end event matching the begin
+           * event recorded by the constructor, if any.
+           */
+          ~Scope()
+          {
+            if(mBegun)
+            {
+              AssetTrace::End();
+            }
+          }
+
+        private:
+          /// True if the constructor recorded a begin event
+          const bool mBegun;
+
+          /**
+           * Our copy constructor is private because we do not allow copies of
+           * our class
+           */
+          Scope(const Scope&); // Intentionally undefined
+
+          /**
+           * Our assignment operator is private because we do not allow copies
+           * of our class
+           */
+          Scope& operator=(const Scope&); // Intentionally undefined
+      }; // class Scope
+
+      /**
+       * Start is responsible for throwing away every event recorded so far
+       * and recording new events until Stop is called. Each thread records
+       * into its own buffer of theCapacity events, events that don't fit
+       * are dropped and counted (see GetDropped). Events being written by
+       * other threads are waited for before their buffers are deleted.
+       * @param[in] theCapacity of events each thread can record
+       */
+      static void Start(Uint32 theCapacity = EVENT_CAPACITY);
+
+      /**
+       * Stop is responsible for no longer recording new begin events. The
+       * events recorded are kept until Start or Clear is called.
+       */
+      static void Stop(void);
+
+      /**
+       * Clear is responsible for stopping the trace and deleting the buffer
+       * of every thread once the events being written by other threads are
+       * done.
+       */
+      static void Clear(void);
+
+      /**
+       * IsRecording will return true if begin events are being recorded.
+       * This is the only cost of each event while the trace is stopped.
+       * @return true if recording, false otherwise
+       */
+      static bool IsRecording(void);
+
+      /**
+       * GetDropped will return the number of begin events that did not fit
+       * in the buffer of their thread since Start was called.
+       * @return the number of events dropped
+       */
+      static Uint64 GetDropped(void);
+
+      /**
+       * SetThreadName is responsible for naming the calling thread in the
+       * trace written. Can be called before Start.
+       * @param[in] theName to give the calling thread
+       */
+      static void SetThreadName(const std::string& theName);
+
+      /**
+       * Begin is responsible for recording a begin event for theName and
+       * theCategory provided on the calling thread. End must be called on
+       * the same thread if and only if true was returned, use Scope to
+       * make sure this happens.
+       * @param[in] theName of the event, must outlive the trace
+       * @param[in] theCategory of the event, must outlive the trace
+       * @return true if the event was recorded, false otherwise
+       */
+      static bool Begin(const char* theName, const char* theCategory);
+
+      /**
+       * Begin is responsible for recording a begin event for theName,
+       * theCategory and theAssetID provided on the calling thread. End must
+       * be called on the same thread if and only if true was returned.
+       * @param[in] theName of the event, must outlive the trace
+       * @param[in] theCategory of the event, must outlive the trace
+       * @param[in] theAssetID the event is for
+       * @return true if the event was recorded, false otherwise
+       */
+      static bool Begin(const char* theName, const char* theCategory,
+        const AssetKey& theAssetID);
+
+      /**
+       * End is responsible for recording the end event of the last begin
+       * event recorded on the calling thread. Room for the end event is
+       * kept by Begin so it is never dropped.
+       */
+      static void End(void);
+
+      /**
+       * Write is responsible for writing every event recorded so far to
+       * theStream in the Trace Event JSON format read by chrome://tracing
+       * and Perfetto. Can be called while other threads are recording,
+       * events recorded during the call may be left out.
+       * @param[in] theStream to write the trace to
+       */
+      static void Write(std::ostream& theStream);
+
+      /**
+       * Write is responsible for writing every event recorded so far to the
+       * file theFilename provided (see Write above).
+       * @param[in] theFilename of the trace file to write
+       * @return true if the trace file was written, false otherwise
+       */
+      static bool Write(const std::string& theFilename);
+
+    private:
+      /**
+       * Record is responsible for adding one event to the buffer of the
+       * calling thread.
+       * @param[in] thePhase of the event, 'B' for begin or 'E' for end
+       * @param[in] theName of the event or NULL for end events
+       * @param[in] theCategory of the event or NULL for end events
+       * @param[in] theAssetID the event is for or NULL if none
+       * @return true if the event was recorded, false otherwise
+       */
+      static bool Record(char thePhase, const char* theName,
+        const char* theCategory, const typeAssetID* theAssetID);
+
+      /**
+       * Our constructor is private because every method is static
+       */
+      AssetTrace(); // Intentionally undefined
+  }; // class AssetTrace
+} // namespace GExL
+
+#endif // CORE_ASSET_TRACE_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetTrace
+ * @ingroup Core
+ * The AssetTrace class records when each asset was acquired, loaded,
+ * finalized and released and when each batch load started and ended, on
+ * which thread, so a slow startup can be opened in chrome://tracing or
+ * https://ui.perfetto.dev to see which assets, handlers and threads the time
+ * went to. Each thread records into its own buffer without taking a lock,
+ * the events of every thread are only gathered by Write. Nothing is recorded
+ * until Start is called.
+ * Example usage:
+ *   GExL::AssetTrace::Start();
+ *   anAssetManager.LoadAllAssets();
+ *   GExL::AssetTrace::Stop();
+ *   GExL::AssetTrace::Write("startup.json");
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
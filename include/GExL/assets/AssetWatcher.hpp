@@ -0,0 +1,140 @@
+/**
+ * Provides the AssetWatcher class in the GExL namespace which is responsible
+ * for watching asset directories for files that change on disk.
+ *
+ * @file include/GExL/assets/AssetWatcher.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_ASSET_WATCHER_HPP_INCLUDED
+#define   CORE_ASSET_WATCHER_HPP_INCLUDED
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <GExL/GExL_types.hpp>
+
+namespace GExL
+{
+  /// Provides a background thread that collects changed asset files
+  class GExL_API AssetWatcher
+  {
+    public:
+      /**
+       * AssetWatcher constructor, nothing is watched until Watch is called.
+       */
+      AssetWatcher();
+
+      /**
+       * AssetWatcher deconstructor will stop the watcher thread.
+       */
+      virtual ~AssetWatcher();
+
+      /**
+       * Watch is responsible for watching theDirectory provided and every
+       * directory below it for files that are written or moved into place.
+       * The watcher thread is started by the first successful call. Changed
+       * files are reported as theDirectory + "/" + the path below it, so use
+       * the same prefix as the filenames given to the asset handlers.
+       * Only supported on Linux (inotify), other platforms return false.
+       * @param[in] theDirectory to watch
+       * @return true if theDirectory is now being watched, false otherwise
+       */
+      bool Watch(const std::string& theDirectory);
+
+      /**
+       * Stop is responsible for stopping the watcher thread and forgetting
+       * every directory being watched.
+       */
+      void Stop(void);
+
+      /**
+       * IsWatching will return true if the watcher thread is running.
+       * @return true if watching, false otherwise
+       */
+      bool IsWatching(void) const;
+
+      /**
+       * GetChanges is responsible for moving every filename that changed
+       * since the last call into theFilenames. Each filename is only
+       * reported once no matter how many times it was written.
+       * @param[out] theFilenames to add each changed filename to
+       */
+      void GetChanges(std::vector<std::string>& theFilenames);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Watcher thread reading change events
+      std::thread mThread;
+      /// True while the watcher thread should keep running
+      std::atomic<bool> mRunning;
+      /// Lock protecting every variable below
+      std::mutex mMutex;
+      /// Platform handle used to read change events or -1 if not open
+      int mHandle;
+      /// Map of each platform watch handle to the directory it watches
+      std::map<int, std::string> mDirectories;
+      /// Filenames that changed since the last call to GetChanges
+      std::set<std::string> mChanges;
+
+      /**
+       * AddDirectory is responsible for watching theDirectory and every
+       * directory below it. mMutex must be held by the caller.
+       * @param[in] theDirectory to watch
+       * @return true if theDirectory is being watched, false otherwise
+       */
+      bool AddDirectory(const std::string& theDirectory);
+
+      /**
+       * Run is the loop the watcher thread executes until Stop is called.
+       */
+      void Run(void);
+
+      /**
+       * Our copy constructor is private because we do not allow copies of our
+       * class
+       */
+      AssetWatcher(const AssetWatcher&); // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies of our
+       * class
+       */
+      AssetWatcher& operator=(const AssetWatcher&); // Intentionally undefined
+  }; // class AssetWatcher
+} // namespace GExL
+
+#endif // CORE_ASSET_WATCHER_HPP_INCLUDED
+
+/**
+ * @class GExL::AssetWatcher
+ * @ingroup Core
+ * The AssetWatcher class is owned by the AssetManager and is used to hot
+ * reload assets whose files change on disk. The watcher thread only collects
+ * the changed filenames, AssetManager::Update hands them to each registered
+ * handler which reloads the matching assets on the loader threads.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
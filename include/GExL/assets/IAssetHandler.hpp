@@ -9,20 +9,79 @@
 #ifndef   CORE_IASSET_HANDLER_HPP_INCLUDED
 #define   CORE_IASSET_HANDLER_HPP_INCLUDED
 
+#include <chrono>
+#include <future>
 #include <map>
+#include <vector>
 #include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
+#include <GExL/assets/AssetLoader.hpp>
+#include <GExL/assets/AssetPack.hpp>
 
 namespace GExL
 {
+  // Forward declare the AssetManager class which registers each handler
+  class AssetManager;
+
   /// Provides the base class interface for all game states
   class GExL_API IAssetHandler
   {
     public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Type index used by handlers that don't manage a single asset TYPE
+      static const Uint32 NO_TYPE_INDEX = 0xFFFFFFFF;
+      /// Number of buckets in the load time histogram of typeAssetStats
+      static const Uint32 LOAD_TIME_BUCKETS = 24;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Structure holding information about the failed loads of an asset
+      struct typeLoadFailure {
+        std::string reason;   ///< Why the last load failed
+        Uint32      failures; ///< Number of loads in a row that failed
+        /// When the last load failed
+        std::chrono::steady_clock::time_point time;
+        /// When the asset may be loaded again, time_point::max() if only by RetryAsset
+        std::chrono::steady_clock::time_point retryTime;
+      };
+
+      /// Structure holding the statistics of a handler (see GetStats)
+      struct typeAssetStats {
+        Uint32 assets;                 ///< Assets currently registered
+        Uint32 assetsMaximum;          ///< Most assets registered at once
+        Uint32 loadedAssets;           ///< Registered assets currently loaded
+        Uint32 deferredAssets;         ///< Unused assets waiting to be released
+        Uint64 residentBytes;          ///< Bytes used by every loaded asset
+        Uint64 residentBytesMaximum;   ///< Most bytes resident at once
+        Uint64 memoryBudget;           ///< Memory budget or 0 for no limit
+        Uint64 referenceHits;          ///< References to an asset already registered
+        Uint64 referenceCreates;       ///< References that registered a new asset
+        Uint64 loads;                  ///< Loads and reloads run
+        Uint64 loadFailures;           ///< Loads and reloads that failed
+        Uint64 coalescedLoads;         ///< Loads joined while in flight
+        Uint64 sharedLoads;            ///< Loads that shared the content of another asset
+        Uint64 loadNanoseconds;        ///< Time spent loading and finalizing
+        Uint64 loadNanosecondsMaximum; ///< Longest single load
+        /// Number of loads by time taken, bucket 0 counts loads under 1
+        /// microsecond, bucket N loads under 2^N microseconds and the last
+        /// bucket every load that took longer
+        Uint64 loadTimes[LOAD_TIME_BUCKETS];
+      };
+
+      /// Structure naming an asset of any handler (see AddDependency)
+      struct typeAssetDependency {
+        IAssetHandler* handler; ///< Handler holding the asset
+        AssetKey       key;     ///< Key of the asset
+      };
+
       /**
        * IAssetHandler default constructor.
        * @param[in] theAssetHandlerID to use for this Resource Handler
+       * @param[in] theTypeIndex of the asset TYPE managed (see GetTypeIndex)
        */
-      IAssetHandler(const typeAssetHandlerID theAssetHandlerID);
+      IAssetHandler(const typeAssetHandlerID theAssetHandlerID,
+        Uint32 theTypeIndex = NO_TYPE_INDEX);
 
       /**
        * IAssetHandler deconstructor
@@ -36,6 +95,27 @@ namespace GExL
        */
       const GExL::typeAssetHandlerID GetID(void) const;
 
+      /**
+       * GetTypeIndex will return the dense type index of the asset TYPE this
+       * IAssetHandler object manages which is used by the AssetManager to
+       * find handlers without any string comparisons.
+       * @return the type index or NO_TYPE_INDEX if this handler has none
+       */
+      Uint32 GetTypeIndex(void) const;
+
+      /**
+       * GetTypeIndex will return the dense type index assigned to the asset
+       * TYPE provided. Each TYPE is given the next free index the first time
+       * it is asked for, after that this is a single static variable read.
+       * @return the type index for asset TYPE
+       */
+      template<class TYPE>
+      static Uint32 GetTypeIndex(void)
+      {
+        static const Uint32 sTypeIndex = NextTypeIndex();
+        return sTypeIndex;
+      }
+
       /**
        * DropReference will decrement the reference counter for theAssetID
        * specified and optionally call the ReleaseAsset virtual function to
@@ -44,16 +124,40 @@ namespace GExL
        * @param[in] theAssetID to drop the reference for
        * @param[in] theDropTime indicates if asset is dropped when count = 0 or exit
        */
-      virtual void DropReference(const typeAssetID theAssetID,
+      virtual void DropReference(const AssetKey& theAssetID,
         AssetDropTime theDropTime = AssetDropUnspecified) = 0;
 
+      /**
+       * AddReference will increment the reference counter for theAssetID
+       * specified, acquiring the asset without loading it if it doesn't exist
+       * yet. Used by AssetManager::LoadGroup which doesn't know the asset
+       * TYPE of each handler. Each call must be matched by DropReference.
+       * @param[in] theAssetID to add the reference for
+       * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or exit
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
+       * @return true if the reference was added, false otherwise
+       */
+      virtual bool AddReference(const AssetKey& theAssetID,
+        AssetLoadStyle theLoadStyle = AssetLoadFromFile,
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible) = 0;
+
       /**
        * IsLoaded will return true if the Resource specified by theResourceID
        * has been loaded.
        * @param[in] theAssetID to the Resource to determine loaded state
        * @return true if loaded, false otherwise
        */
-      virtual bool IsLoaded(const typeAssetID theAssetID) const = 0;
+      virtual bool IsLoaded(const AssetKey& theAssetID) const = 0;
+
+      /**
+       * IsLoading will return true if the Resource specified by theAssetID is
+       * currently being loaded by some thread.
+       * @param[in] theAssetID to the Resource to determine loading state
+       * @return true if a load is in flight, false otherwise
+       */
+      virtual bool IsLoading(const AssetKey& theAssetID) const = 0;
 
       /**
        * GetFilename is responsible for retrieving the filename to use when
@@ -61,7 +165,7 @@ namespace GExL
        * @param[in] theAssetID to get filename for
        * @return std::String filename for theAssetID provided
        */
-      virtual const std::string GetFilename(const typeAssetID theAssetID) const = 0;
+      virtual const std::string GetFilename(const AssetKey& theAssetID) const = 0;
 
       /**
        * SetFilename is responsible for noting the filename to use when loading
@@ -69,7 +173,7 @@ namespace GExL
        * @param[in] theAssetID to set filename for
        * @param[in] theFilename to use when loading this asset from a file
        */
-      virtual void SetFilename(const typeAssetID theAssetID, std::string theFilename) = 0;
+      virtual void SetFilename(const AssetKey& theAssetID, std::string theFilename) = 0;
 
       /**
        * GetLoadStyle allows someone to find out the loading style of
@@ -77,7 +181,7 @@ namespace GExL
        * @param[in] theAssetID of the asset to find loading style for
        * @return the loading style for the asset or LoadFromUnknown otherwise
        */
-      virtual AssetLoadStyle GetLoadStyle(const typeAssetID theAssetID) const = 0;
+      virtual AssetLoadStyle GetLoadStyle(const AssetKey& theAssetID) const = 0;
 
       /**
        * SetLoadStyle allows someone to change the loading style of theAssetID
@@ -86,7 +190,7 @@ namespace GExL
        * @param[in] theAssetID of the asset to change loading style
        * @param[in] theLoadStyle (File,Mem,Network) to use when loading this asset
        */
-      virtual void SetLoadStyle(const typeAssetID theAssetID, AssetLoadStyle theLoadStyle) = 0;
+      virtual void SetLoadStyle(const AssetKey& theAssetID, AssetLoadStyle theLoadStyle) = 0;
 
       /**
        * GetLoadTime allows someone to find out the loading time of
@@ -94,7 +198,7 @@ namespace GExL
        * @param[in] theAssetID of the asset to find loading time for
        * @return the loading style for the asset or LoadFromUnknown otherwise
        */
-      virtual AssetLoadTime GetLoadTime(const typeAssetID theAssetID) const = 0;
+      virtual AssetLoadTime GetLoadTime(const AssetKey& theAssetID) const = 0;
 
       /**
        * SetLoadTime allows someone to change the loading time of theAssetID
@@ -103,7 +207,7 @@ namespace GExL
        * @param[in] theAssetID of the asset to change loading time
        * @param[in] theLoadTime (Now,Later) of when to load this asset
        */
-      virtual void SetLoadTime(const typeAssetID theAssetID, AssetLoadTime theLoadTime) = 0;
+      virtual void SetLoadTime(const AssetKey& theAssetID, AssetLoadTime theLoadTime) = 0;
 
       /**
        * LoadAsset is responsible for loading the asset specified by theAssetID
@@ -112,7 +216,28 @@ namespace GExL
        * @param[in] theAssetID of the asset to load
        * @return bool true if theAssetID was found and loaded, false otherwise
        */
-      virtual bool LoadAsset(const typeAssetID theAssetID) = 0;
+      virtual bool LoadAsset(const AssetKey& theAssetID) = 0;
+
+      /**
+       * LoadAssetAsync is responsible for loading the asset specified by
+       * theAssetID on one of the AssetManager loader threads. If the asset is
+       * already being loaded then theCallback is added to the load in flight.
+       * @param[in] theAssetID of the asset to load
+       * @param[in] theCallback to call on the loader thread once the load completes
+       * @return future that will hold true if the asset was loaded, false otherwise
+       */
+      virtual std::shared_future<bool> LoadAssetAsync(const AssetKey& theAssetID,
+        typeAssetLoadCallback theCallback = typeAssetLoadCallback()) = 0;
+
+      /**
+       * RaisePriority is responsible for raising the priority of the load of
+       * theAssetID to thePriority if it is still waiting for a loader thread.
+       * Loads are never lowered to a lesser priority.
+       * @param[in] theAssetID of the asset to raise the priority of
+       * @param[in] thePriority (Prefetch, Visible, Critical) to raise it to
+       */
+      virtual void RaisePriority(const AssetKey& theAssetID,
+        AssetLoadPriority thePriority) = 0;
 
       /**
        * LoadAllAssets is responsible for loading all unloaded assets that are
@@ -121,13 +246,276 @@ namespace GExL
        */
       virtual bool LoadAllAssets(void) = 0;
 
+      /**
+       * LoadAllAssetsAsync is responsible for starting the load of every
+       * unloaded asset currently registered with this IAssetHandler derived
+       * class on the AssetManager loader threads (see LoadAssetAsync).
+       * @param[out] theFutures to add the future of each load started to
+       */
+      virtual void LoadAllAssetsAsync(std::vector<std::shared_future<bool> >& theFutures) = 0;
+
+      /**
+       * LoadPendingAssets is responsible for loading unloaded AssetLoadLater
+       * assets on the calling thread until theDeadline has passed. Each call
+       * continues where the previous call ran out of time.
+       * @param[in] theDeadline after which no more loads are started
+       * @return the number of AssetLoadLater assets still waiting to be
+       *   loaded, assets whose last load failed aren't counted
+       */
+      virtual Uint32 LoadPendingAssets(std::chrono::steady_clock::time_point theDeadline) = 0;
+
+      /**
+       * FinalizeLoads is responsible for finishing every asset loaded on the
+       * loader threads that must be finished on the thread that uses the
+       * assets, such as creating a renderer texture. Call this regularly
+       * from that thread (see AssetManager::Update), the loads aren't done
+       * until it is called.
+       */
+      virtual void FinalizeLoads(void) = 0;
+
+      /**
+       * IsFinalizeThread will return true if the calling thread is the one
+       * that calls FinalizeLoads (see AssetManager::IsFinalizeThread), always
+       * true if this handler hasn't been registered yet. Only that thread may
+       * finalize loads while waiting for them.
+       * @return true if the calling thread finalizes loads, false otherwise
+       */
+      bool IsFinalizeThread(void) const;
+
+      /**
+       * GetLoadNanoseconds returns the total time this handler has spent
+       * loading and finalizing assets, summed across every thread.
+       * @return the total load time in nanoseconds
+       */
+      virtual Uint64 GetLoadNanoseconds(void) const = 0;
+
+      /**
+       * GetCoalescedLoads returns the number of times a load of an asset
+       * already in flight was joined instead of loading it a second time.
+       * @return the number of loads coalesced
+       */
+      virtual Uint64 GetCoalescedLoads(void) const = 0;
+
+      /**
+       * GetStats is responsible for filling theStats with the counters of
+       * this handler. The counters are read one at a time while assets keep
+       * being used so they may not all agree with each other exactly.
+       * @param[out] theStats to fill
+       */
+      virtual void GetStats(typeAssetStats& theStats) const = 0;
+
+      /**
+       * SetMemoryBudget sets the number of bytes this handler may keep
+       * resident before unused AssetDropLRU assets are released, oldest
+       * first. A budget of 0 (default) means there is no limit.
+       * @param[in] theBytes this handler may keep resident or 0 for no limit
+       */
+      virtual void SetMemoryBudget(Uint64 theBytes) = 0;
+
+      /**
+       * GetMemoryBudget returns the memory budget set by SetMemoryBudget.
+       * @return the memory budget in bytes or 0 if there is no limit
+       */
+      virtual Uint64 GetMemoryBudget(void) const = 0;
+
+      /**
+       * GetResidentBytes returns the number of bytes used by every loaded
+       * asset this handler manages as reported by each asset size.
+       * @return the number of bytes currently resident
+       */
+      virtual Uint64 GetResidentBytes(void) const = 0;
+
+      /**
+       * TrimCache is responsible for releasing unused AssetDropLRU assets,
+       * least recently used first, until at least theBytes have been freed
+       * or no unused assets remain.
+       * @param[in] theBytes to try to free
+       * @return the number of bytes actually freed
+       */
+      virtual Uint64 TrimCache(Uint64 theBytes) = 0;
+
+      /**
+       * ReleaseDeferredAssets is responsible for releasing unused
+       * AssetDropDeferred assets, oldest first, until theDeadline has passed.
+       * A release that has started is never interrupted.
+       * @param[in] theDeadline after which no more assets are released
+       * @return the number of AssetDropDeferred assets still waiting
+       */
+      virtual Uint32 ReleaseDeferredAssets(std::chrono::steady_clock::time_point theDeadline) = 0;
+
+      /**
+       * ReloadFile is responsible for reloading every loaded asset whose
+       * filename matches theFilename provided, typically because the file
+       * changed on disk (see AssetManager::WatchDirectory).
+       * @param[in] theFilename that changed on disk
+       * @return the number of assets being reloaded or released
+       */
+      virtual Uint32 ReloadFile(const std::string& theFilename) = 0;
+
+      /**
+       * FinishReloads is responsible for swapping every asset reloaded by
+       * ReloadFile into place without changing the asset address held by
+       * each TAsset.
+       */
+      virtual void FinishReloads(void) = 0;
+
+      /**
+       * SetRetryDelay sets how long to wait before loading an asset again
+       * after a load fails. The delay starts at theInitialDelay and doubles
+       * after each failure in a row up to theMaximumDelay. An initial delay
+       * of 0 means failed assets are only loaded again by RetryAsset.
+       * @param[in] theInitialDelay in milliseconds after the first failure
+       * @param[in] theMaximumDelay in milliseconds after many failures
+       */
+      virtual void SetRetryDelay(Uint32 theInitialDelay, Uint32 theMaximumDelay) = 0;
+
+      /**
+       * SetContentSharing enables or disables content sharing for assets
+       * loaded from now on. While enabled the source bytes of each
+       * AssetLoadFromFile and AssetLoadFromMemory asset are hashed before
+       * it is loaded and assets whose bytes match an asset already loaded
+       * share its TYPE instead of loading their own copy. Disabled by
+       * default since hashing files costs an extra read of each file.
+       * @param[in] theEnabled true to share identical content, false otherwise
+       */
+      virtual void SetContentSharing(bool theEnabled) = 0;
+
+      /**
+       * IsContentSharing returns the value set by SetContentSharing.
+       * @return true if identical content is shared, false otherwise
+       */
+      virtual bool IsContentSharing(void) const = 0;
+
+      /**
+       * GetLoadFailure is responsible for retrieving why the last load of
+       * theAssetID failed and when it may be loaded again.
+       * @param[in] theAssetID of the asset to check
+       * @param[out] theFailure information about the failed loads
+       * @return true if the last load of theAssetID failed, false otherwise
+       */
+      virtual bool GetLoadFailure(const AssetKey& theAssetID,
+        typeLoadFailure& theFailure) const = 0;
+
+      /**
+       * RetryAsset is responsible for loading theAssetID again right away
+       * even if its retry delay has not passed yet.
+       * @param[in] theAssetID of the asset to load again
+       * @return true if theAssetID was loaded, false otherwise
+       */
+      virtual bool RetryAsset(const AssetKey& theAssetID) = 0;
+
+      /**
+       * AddDependency is responsible for recording that theAssetID depends on
+       * theDependencyID of theHandler, which may be this handler. A reference
+       * to the dependency is held, acquiring it without loading it if needed,
+       * until theAssetID is deleted. Dependencies can be added before or
+       * during the load of theAssetID from any thread, AssetManager::LoadGraph
+       * loads every dependency before the assets depending on it. A
+       * dependency that would make a cycle is refused.
+       * @param[in] theAssetID of the asset that depends on the other
+       * @param[in] theHandler holding the dependency
+       * @param[in] theDependencyID of the asset depended on
+       * @return true if the dependency is recorded, false otherwise
+       */
+      virtual bool AddDependency(const AssetKey& theAssetID,
+        IAssetHandler& theHandler, const AssetKey& theDependencyID) = 0;
+
+      /**
+       * GetDependencies is responsible for adding every asset theAssetID
+       * depends on to theDependencies in the order they were added.
+       * @param[in] theAssetID of the asset to get the dependencies of
+       * @param[out] theDependencies to add each dependency to
+       */
+      virtual void GetDependencies(const AssetKey& theAssetID,
+        std::vector<typeAssetDependency>& theDependencies) const = 0;
+
+      /**
+       * ClearDependencies is responsible for dropping the references every
+       * asset of this handler holds to its dependencies. The AssetManager
+       * calls this for every handler before any handler is deleted.
+       */
+      virtual void ClearDependencies(void) = 0;
+
+      /**
+       * GetUnloadedAssets is responsible for adding the key of every asset
+       * registered with this handler that is not loaded to theAssetIDs.
+       * @param[out] theAssetIDs to add each unloaded asset key to
+       */
+      virtual void GetUnloadedAssets(std::vector<AssetKey>& theAssetIDs) = 0;
+
+      /**
+       * IsDependency will return true if theAssetID of this handler depends
+       * on theDependencyID of theHandler directly or through other
+       * dependencies.
+       * @param[in] theAssetID of the asset to check the dependencies of
+       * @param[in] theHandler holding the dependency to look for
+       * @param[in] theDependencyID of the dependency to look for
+       * @return true if theAssetID depends on theDependencyID, false otherwise
+       */
+      bool IsDependency(const AssetKey& theAssetID,
+        const IAssetHandler& theHandler, const AssetKey& theDependencyID) const;
+
     protected:
+      /**
+       * GetAssetManager will return the AssetManager this handler was
+       * registered with or NULL if it hasn't been registered yet.
+       * @return pointer to the AssetManager or NULL otherwise
+       */
+      AssetManager* GetAssetManager(void) const;
+
+      /**
+       * AddLoadTask is responsible for queuing theTask on the loader threads
+       * of the AssetManager this handler was registered with.
+       * @param[in] theTask to run on a loader thread
+       * @param[in] thePriority (Prefetch, Visible, Critical) of theTask
+       * @return true if theTask was queued, false if there is no AssetManager
+       */
+      bool AddLoadTask(AssetLoader::typeLoadTask theTask,
+        AssetLoadPriority thePriority = AssetLoadVisible);
+
+      /**
+       * CheckGlobalMemoryBudget is responsible for asking the AssetManager
+       * this handler was registered with to enforce its global memory budget
+       * (see AssetManager::SetMemoryBudget).
+       */
+      void CheckGlobalMemoryBudget(void);
+
+      /**
+       * GetPackData is responsible for finding the bytes of theAssetID in the
+       * asset packs mounted on the AssetManager this handler was registered
+       * with (see AssetManager::MountPack). Derived LoadFromMemory methods
+       * typically use this to load assets straight from the pack mapping.
+       * Compressed assets are decompressed into theBuffer which must be kept
+       * as long as theSpan is used.
+       * @param[in] theAssetID to find
+       * @param[out] theSpan of the asset bytes if found
+       * @param[out] theBuffer to decompress compressed assets into
+       * @return true if theAssetID was found in a mounted pack, false otherwise
+       */
+      bool GetPackData(const AssetKey& theAssetID, AssetSpan& theSpan,
+        std::vector<Uint8>& theBuffer) const;
+
+      /**
+       * FindHandler is responsible for finding the handler registered under
+       * theAssetHandlerID with the AssetManager this handler was registered
+       * with, used to name the handler of a dependency.
+       * @param[in] theAssetHandlerID to find
+       * @return the handler found or NULL if there is none
+       */
+      IAssetHandler* FindHandler(const typeAssetHandlerID theAssetHandlerID) const;
 
     private:
+      // The AssetManager is responsible for setting mAssetManager
+      friend class AssetManager;
+
       // Variables
       ///////////////////////////////////////////////////////////////////////////
       /// ID specified for this IAssetHandler
       const typeAssetHandlerID mAssetHandlerID;
+      /// Dense type index of the asset TYPE managed by this IAssetHandler
+      const Uint32 mTypeIndex;
+      /// AssetManager this handler was registered with
+      AssetManager* mAssetManager;
 
       /**
        * Our copy constructor is private because we do not allow copies of our
@@ -140,6 +528,13 @@ namespace GExL
        * class
        */
       IAssetHandler& operator=(const IAssetHandler&); // Intentionally undefined
+
+      /**
+       * NextTypeIndex is responsible for handing out the next unused type
+       * index for GetTypeIndex.
+       * @return the next unused type index
+       */
+      static Uint32 NextTypeIndex(void);
   }; // class IAssetHandler
 } // namespace GExL
 
@@ -12,6 +12,7 @@
 
 #include <string>
 #include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
 #include <GExL/assets/AssetManager.hpp>
 #include <GExL/assets/TAssetHandler.hpp>
 
@@ -27,17 +28,22 @@ namespace GExL
        * allows theAssetManager to provide the asset at construction time.
        * @param[in] theAssetManager reference to the assetmanager this asset should use
        * @param[in] theAssetID to use for this asset
-       * @param[in] theLoadTime (Now, Later) of when to load this asset
+       * @param[in] theLoadTime (Now, Later, Async) of when to load this asset
        * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
-       * @param[in] theDropTime at (Zero, Exit) for when to unload this asset
+       * @param[in] theDropTime at (Zero, Exit, LRU, Deferred) for when to unload this asset
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
        */
-      TAsset(AssetManager& theAssetManager, const typeAssetID theAssetID,
+      TAsset(AssetManager& theAssetManager, const AssetKey& theAssetID,
         AssetLoadTime theLoadTime = AssetLoadLater,
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
-        AssetDropTime theDropTime = AssetDropAtZero):
-        mAssetHandler(theAssetManager.GetHandler<TYPE>()),
-        mAsset(mAssetHandler.GetReference(theAssetID, theLoadTime, theLoadStyle, theDropTime)),
-        mAssetID(theAssetID)
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible):
+        mAssetHandler(&theAssetManager.GetHandler<TYPE>()),
+        mAssetData(mAssetHandler->AcquireReference(theAssetID, theLoadTime,
+          theLoadStyle, theDropTime, thePriority)),
+        mAsset(NULL != mAssetData ? mAssetData->asset.load() : mAssetHandler->GetReference()),
+        mAssetID(theAssetID),
+        mLoaded(false)
       {
       }
 
@@ -49,25 +55,51 @@ namespace GExL
        * @param[in] theAssetManager reference to the assetmanager this asset should use
        */
       TAsset(AssetManager& theAssetManager):
-        mAssetHandler(theAssetManager.GetHandler<TYPE>()),
-        mAsset(mAssetHandler.GetReference())
+        mAssetHandler(&theAssetManager.GetHandler<TYPE>()),
+        mAssetData(NULL),
+        mAsset(mAssetHandler->GetReference()),
+        mLoaded(false)
       {
       }
 
       /**
        * TAsset copy constructor will allow for copying of assets by
-       * incrementing the reference counter for this asset through the
-       * Asset Handler provided at construction time.
+       * incrementing the reference counter of the asset control block, no
+       * asset ID lookup is needed.
        * @param[in] theCopy reference construct a copy of
        */
       TAsset(const TAsset<TYPE>& theCopy) :
         mAssetHandler(theCopy.mAssetHandler),
-        mAssetID(theCopy.mAssetID)
+        mAssetData(theCopy.mAssetData),
+        mAsset(theCopy.mAsset),
+        mAssetID(theCopy.mAssetID),
+        mLoaded(theCopy.mLoaded)
       {
         // Increment reference count to this asset
-        mAsset = mAssetHandler.GetReference(mAssetID);
+        if(NULL != mAssetData)
+        {
+          mAssetHandler->AddReference(mAssetData);
+        }
+      }
+
+      /**
+       * TAsset move constructor will take over the reference held by
+       * theOther without touching the reference counter. theOther is left
+       * referring to the dummy asset.
+       * @param[in] theOther to move the asset reference from
+       */
+      TAsset(TAsset<TYPE>&& theOther) :
+        mAssetHandler(theOther.mAssetHandler),
+        mAssetData(theOther.mAssetData),
+        mAsset(theOther.mAsset),
+        mAssetID(theOther.mAssetID),
+        mLoaded(theOther.mLoaded)
+      {
+        // theOther no longer holds a reference
+        theOther.mAssetData = NULL;
+        theOther.mAsset = mAssetHandler->GetReference();
+        theOther.mLoaded = false;
       }
-      
 
       /**
        * TAsset deconstructor
@@ -75,7 +107,10 @@ namespace GExL
       virtual ~TAsset()
       {
         // Drop reference to this asset
-        mAssetHandler.DropReference(mAssetID);
+        if(NULL != mAssetData)
+        {
+          mAssetHandler->DropReference(mAssetData);
+        }
       }
 
       /**
@@ -84,7 +119,18 @@ namespace GExL
        */
       bool IsLoaded(void) const
       {
-        return mAssetHandler.IsLoaded(mAssetID);
+        return mLoaded || (NULL != mAssetData &&
+          mAssetData->loaded.load(std::memory_order_acquire));
+      }
+
+      /**
+       * IsLoading will return true if the Asset is currently being loaded,
+       * typically by one of the AssetManager loader threads.
+       * @return true if a load is in flight, false otherwise
+       */
+      bool IsLoading(void) const
+      {
+        return mAssetHandler->IsLoading(mAssetID);
       }
 
       /**
@@ -92,51 +138,109 @@ namespace GExL
        * @return the Asset ID assigned to this asset
        */
       const typeAssetID GetID(void) const
+      {
+        return mAssetID.GetID();
+      }
+
+      /**
+       * GetKey will return the interned key being used for this asset.
+       * @return the Asset Key assigned to this asset
+       */
+      const AssetKey& GetKey(void) const
       {
         return mAssetID;
       }
 
+      /**
+       * GetHandle will return the generational handle of this asset, which
+       * can be kept without holding a reference (see SetHandle).
+       * @return the handle or INVALID_HANDLE if no asset is referenced
+       */
+      typename TAssetHandler<TYPE>::typeAssetHandle GetHandle(void) const
+      {
+        return mAssetHandler->GetHandle(mAssetData);
+      }
+
+      /**
+       * SetHandle will get a reference to the asset theHandle refers to
+       * instead of the asset currently referenced. Nothing is changed if
+       * theHandle is stale because its asset was released.
+       * @param[in] theHandle returned by GetHandle to reference
+       * @return true if theHandle is now referenced, false if it was stale
+       */
+      bool SetHandle(typename TAssetHandler<TYPE>::typeAssetHandle theHandle)
+      {
+        // Try to obtain a reference to the Asset from Handler
+        typename TAssetHandler<TYPE>::typeAssetData* anAssetData =
+          mAssetHandler->AcquireHandle(theHandle);
+        if(NULL == anAssetData)
+        {
+          return false;
+        }
+
+        // Drop the reference to the previous Asset
+        if(NULL != mAssetData)
+        {
+          mAssetHandler->DropReference(mAssetData);
+        }
+
+        // Make note of the new Asset ID
+        mAssetID = anAssetData->key;
+        mAssetData = anAssetData;
+        mAsset = mAssetData->asset;
+        mLoaded = false;
+        return true;
+      }
+
       /**
        * SetID will set the ID for this asset and get a reference to the
        * asset.
        * @param[in] theAssetID to use for this asset
-       * @param[in] theLoadTime (Now, Later) of when to load this asset
+       * @param[in] theLoadTime (Now, Later, Async) of when to load this asset
        * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
-       * @param[in] theDropTime at (Zero, Exit) for when to unload this asset
+       * @param[in] theDropTime at (Zero, Exit, LRU, Deferred) for when to unload this asset
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
        */
-      void SetID(const typeAssetID theAssetID,
+      void SetID(const AssetKey& theAssetID,
         AssetLoadTime theLoadTime = AssetLoadLater,
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
-        AssetDropTime theDropTime = AssetDropAtZero)
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible)
       {
+        // Try to obtain a reference to the new Asset from Handler
+        typename TAssetHandler<TYPE>::typeAssetData* anAssetData =
+          mAssetHandler->AcquireReference(theAssetID, theLoadTime, theLoadStyle,
+            theDropTime, thePriority);
+
+        // Drop the reference to the previous Asset
+        if(NULL != mAssetData)
+        {
+          mAssetHandler->DropReference(mAssetData);
+        }
+
         // Make note of the new Asset ID
         mAssetID = theAssetID;
-
-        // Try to obtain a reference to the new Asset from Handler
-        mAsset = mAssetHandler.GetReference(mAssetID, theLoadTime, theLoadStyle, theDropTime);
+        mAssetData = anAssetData;
+        mAsset = (NULL != mAssetData) ? mAssetData->asset.load() : mAssetHandler->GetReference();
+        mLoaded = false;
       }
 
       /**
-       * GetAsset will return the Asset if it is available.
-       * @return pointer to the Asset or NULL if not available yet.
+       * GetAsset will return the Asset if it is available. The dummy asset is
+       * returned while the Asset is still being loaded by another thread.
+       * Once the Asset has been seen loaded this is a single pointer
+       * dereference since our reference keeps the Asset at the same address.
+       * @return reference to the Asset or the dummy asset if not available yet.
        */
       TYPE& GetAsset(void)
       {
-        // Is asset not yet loaded, then try to load it immediately
-        if(false == mAssetHandler.IsLoaded(mAssetID))
+        // Is asset not yet known to be loaded, then check or load it now
+        if(false == mLoaded)
         {
-          // Load the asset immediately
-          bool anLoaded = mAssetHandler.LoadAsset(mAssetID);
-
-          // If the asset was loaded, get a reference to it now
-          if(anLoaded)
-          {
-            // Get reference to the asset immediately
-            mAsset = mAssetHandler.GetReference(mAssetID);
-          }
+          return LoadAsset();
         }
 
-        // Return reference to dummy asset or loaded asset
+        // Return reference to the loaded asset
         return *mAsset;
       }
 
@@ -147,7 +251,7 @@ namespace GExL
        */
       const std::string GetFilename(void)
       {
-        return mAssetHandler.GetFilename(mAssetID);
+        return mAssetHandler->GetFilename(mAssetID);
       }
 
       /**
@@ -158,7 +262,7 @@ namespace GExL
       void SetFilename(std::string theFilename)
       {
         // Set the filename to use for this asset
-        mAssetHandler.SetFilename(mAssetID, theFilename);
+        mAssetHandler->SetFilename(mAssetID, theFilename);
       }
 
       /**
@@ -169,7 +273,7 @@ namespace GExL
        */
       AssetLoadStyle GetLoadStyle(void) const
       {
-        return mAssetHandler.GetLoadStyle(mAssetID);
+        return mAssetHandler->GetLoadStyle(mAssetID);
       }
 
       /**
@@ -179,7 +283,7 @@ namespace GExL
        */
       void SetLoadTime(AssetLoadStyle theLoadStyle)
       {
-        mAssetHandler.SetLoadStyle(mAssetID, theLoadStyle);
+        mAssetHandler->SetLoadStyle(mAssetID, theLoadStyle);
       }
 
       /**
@@ -190,17 +294,17 @@ namespace GExL
        */
       AssetLoadTime GetLoadTime(void) const
       {
-        return mAssetHandler.GetLoadTime(mAssetID);
+        return mAssetHandler->GetLoadTime(mAssetID);
       }
 
       /**
        * SetLoadTime will set the load time for this asset to theLoadTime
        * specified.
-       * @param[in] theLoadTime (Now, Later) of when to load this asset
+       * @param[in] theLoadTime (Now, Later, Async) of when to load this asset
        */
       void SetLoadTime(AssetLoadTime theLoadTime)
       {
-        mAssetHandler.SetLoadTime(mAssetID, theLoadTime);
+        mAssetHandler->SetLoadTime(mAssetID, theLoadTime);
       }
 
       /**
@@ -211,33 +315,33 @@ namespace GExL
        */
       AssetDropTime GetDropTime(void) const
       {
-        return mAssetHandler.GetDropTime(mAssetID);
+        return mAssetHandler->GetDropTime(mAssetID);
       }
 
       /**
        * SetDropTime will set the drop time for this asset to theDropTime
        * specified.
-       * @param[in] theDropTime at (Zero, Exit) for when to unload this asset
+       * @param[in] theDropTime at (Zero, Exit, LRU, Deferred) for when to unload this asset
        */
       void SetDropTime(AssetDropTime theDropTime)
       {
-        mAssetHandler.SetDropTime(mAssetID, theDropTime);
+        mAssetHandler->SetDropTime(mAssetID, theDropTime);
       }
 
       /**
        * TAsset assignment operator will allow for copying of assets by
-       * incrementing the reference count for this asset.
+       * incrementing the reference count for this asset. Since theRight is
+       * passed by value this is also the move assignment operator, in which
+       * case theRight is move constructed and no reference count is touched.
        * @param[in] theRight hand side of the = operation
        * @return the left hand side of the = operator
        */
       TAsset<TYPE>& operator=(TAsset<TYPE> theRight)
       {
-        // Now swap my local copy with theRight copy made during the call to this method
+        // Now swap my local copy with theRight copy made during the call to
+        // this method, theRight will drop the reference I used to hold
         swap(*this, theRight);
 
-        // Increment the reference count to this Asset
-        mAssetHandler.GetReference(mAssetID);
-
         // Return my pointer
         return *this;
       }
@@ -255,20 +359,77 @@ namespace GExL
         // enable ADL
         using std::swap;
 
-        // Swap our asset pointer and ID
+        // Swap our handler, control block, asset pointer and ID
+        swap(first.mAssetHandler, second.mAssetHandler);
+        swap(first.mAssetData, second.mAssetData);
         swap(first.mAsset, second.mAsset);
         swap(first.mAssetID, second.mAssetID);
-        // The mAssetHandler is already handled at construction time
+        swap(first.mLoaded, second.mLoaded);
       }
     protected:
+      /**
+       * LoadAsset is the slow path of GetAsset which is responsible for
+       * checking the loaded state of the control block and loading the Asset
+       * immediately if nobody else has loaded or is loading it.
+       * @return reference to the Asset or the dummy asset if not available yet.
+       */
+      TYPE& LoadAsset(void)
+      {
+        // No Asset ID was provided? then there is nothing to load
+        if(NULL == mAssetData)
+        {
+          return *mAsset;
+        }
+
+        // Has someone else loaded the asset since we last checked?
+        if(mAssetData->loaded.load(std::memory_order_acquire))
+        {
+          mLoaded = true;
+        }
+        // Did the last load fail recently? use the dummy asset without any I/O
+        else if(mAssetHandler->IsRetryPending(mAssetData))
+        {
+          return *mAssetHandler->GetReference();
+        }
+        // Don't wait for or touch an asset that is still being loaded, but
+        // it is needed now so load it before anything else
+        else if(mAssetHandler->IsLoading(mAssetID))
+        {
+          mAssetHandler->RaisePriority(mAssetData, AssetLoadCritical);
+          return *mAssetHandler->GetReference();
+        }
+        // Load the asset immediately, our reference is all we need
+        else
+        {
+          mLoaded = mAssetHandler->LoadAsset(mAssetID);
+
+          // Failed or did another thread claim the load first? use the dummy asset
+          if(false == mLoaded)
+          {
+            return *mAssetHandler->GetReference();
+          }
+        }
+
+        // The loaded asset may share the TYPE of another (see
+        // IAssetHandler::SetContentSharing)
+        mAsset = mAssetData->asset;
+
+        // Return reference to the loaded asset or the unloaded asset
+        return *mAsset;
+      }
+
       // Variables
       ///////////////////////////////////////////////////////////////////////////
       /// Asset Handler class that will manage this asset
-      TAssetHandler<TYPE>& mAssetHandler;
+      TAssetHandler<TYPE>* mAssetHandler;
+      /// Control block of this asset or NULL if no Asset ID was provided
+      typename TAssetHandler<TYPE>::typeAssetData* mAssetData;
       /// Pointer to the loaded asset
       TYPE*                mAsset;
-      /// Asset ID specified for this asset
-      typeAssetID          mAssetID;
+      /// Interned Asset ID specified for this asset
+      AssetKey             mAssetID;
+      /// True once this asset has been seen loaded, enables the GetAsset fast path
+      bool                 mLoaded;
   }; // class TAsset
 } // namespace GExL
 
@@ -279,7 +440,9 @@ namespace GExL
  * @ingroup Core
  * The TAsset template class is the template used to create a new asset type
  * reference.  It provides indirect reference counting and dummy asset
- * references if no Asset ID is provided (see IAssetHandler).
+ * references if no Asset ID is provided (see IAssetHandler). Each TAsset
+ * holds a pointer to the control block of its asset so copies only
+ * increment an atomic counter and moves don't touch the counter at all.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -10,10 +10,25 @@
 #define   CORE_TASSET_HANDLER_HPP_INCLUDED
 
 #include <GExL/GExL_types.hpp>
+#include <GExL/assets/AssetKey.hpp>
+#include <GExL/assets/AssetTrace.hpp>
 #include <GExL/assets/IAssetHandler.hpp>
+#include <GExL/container/THashTable.hpp>
+#include <GExL/container/TPool.hpp>
 #include <GExL/logger/Log_macros.hpp>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
 
 namespace GExL
 {
@@ -21,13 +36,137 @@ namespace GExL
   class TAssetHandler : public IAssetHandler
   {
     public:
+      // Constants
+      ///////////////////////////////////////////////////////////////////////////
+      /// Number of independently locked shards the asset table is split into
+      static const size_t SHARD_COUNT = 32;
+      /// Default milliseconds to wait before loading a failed asset again
+      static const Uint32 RETRY_DELAY = 1000;
+      /// Default longest milliseconds to wait before loading a failed asset again
+      static const Uint32 RETRY_DELAY_MAXIMUM = 60000;
+      /// Retry time used when a failed asset may only be loaded by RetryAsset
+      static const Uint64 RETRY_NEVER = 0xFFFFFFFFFFFFFFFFULL;
+      /// Number of assets and Asset Data structures each shard allocates at once
+      static const Uint32 POOL_CHUNK_SIZE = 64;
+      /// Number of slot chunks the slot chunk directory starts with room for
+      static const Uint32 SLOT_DIRECTORY_SIZE = 64;
+
+      // Types
+      ///////////////////////////////////////////////////////////////////////////
+      /// Generational handle to an asset, the slot in the low 32 bits and
+      /// the generation of the slot in the high 32 bits
+      typedef Uint64 typeAssetHandle;
+      /// Handle that never refers to an asset
+      static const typeAssetHandle INVALID_HANDLE = 0;
+
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Structure holding information about a load that is in flight
+      struct typeLoadRequest {
+        std::promise<bool>                 promise;   ///< Result of the load
+        std::shared_future<bool>           future;    ///< Future for the promise above
+        std::vector<typeAssetLoadCallback> callbacks; ///< Called when the load completes
+        std::atomic<bool>                  started;   ///< Has a thread started this load?
+        AssetLoadPriority                  priority;  ///< Highest priority the load was queued at
+      };
+
+      /// Structure holding information about each Resource, this is the
+      /// control block each TAsset holds a pointer to. The fields scanned
+      /// most often live in the parallel arrays of the slot chunk holding
+      /// the structure (see typeSlotChunk) and are reached by reference.
+      struct typeAssetData {
+        /**
+         * typeAssetData constructor binds the hot fields to theSlot of the
+         * slot chunk provided.
+         * @param[in] theSlot index of this Asset Data in the slot map
+         * @param[in] theCount entry for this slot
+         * @param[in] theLoaded entry for this slot
+         * @param[in] theLoadStyle entry for this slot
+         */
+        typeAssetData(Uint32 theSlot, std::atomic<Uint32>& theCount,
+          std::atomic<bool>& theLoaded, AssetLoadStyle& theLoadStyle) :
+          slot(theSlot),
+          count(theCount),
+          loaded(theLoaded),
+          loadStyle(theLoadStyle)
+        {
+        }
+
+        const Uint32   slot;      ///< Index of this Asset Data in the slot map
+        std::atomic<Uint32>& count; ///< Number of people referencing this Asset
+        std::atomic<bool>& loaded; ///< Is the Asset currently loaded?
+        AssetLoadStyle& loadStyle; ///< Load type (File, Memory, Network, etc)
+        AssetKey       key;       ///< Interned asset ID of this asset
+        std::atomic<TYPE*> asset; ///< The asset being shared (see content)
+        std::string    filename;  ///< Filename if it differs from the asset ID
+        AssetLoadTime  loadTime;  ///< Load time (Now, later)
+        AssetDropTime  dropTime;  ///< Drop time at (Zero, Exit, LRU, Deferred)
+        AssetLoadPriority priority; ///< Load priority (Prefetch, Visible, Critical)
+        Uint64         size;      ///< Bytes used by the Asset once loaded
+        typeAssetData* cachePrev; ///< More recently used unused Asset in the cache
+        typeAssetData* cacheNext; ///< Less recently used unused Asset in the cache
+        /// Steady clock nanoseconds before which a failed Asset isn't loaded
+        /// again, 0 if it may be loaded or RETRY_NEVER
+        std::atomic<Uint64> retryTime;
+        /// Failed loads of this Asset or NULL if the last load didn't fail
+        std::unique_ptr<typeLoadFailure> failure;
+        bool           cached;    ///< Is the Asset unused and waiting in the cache?
+        bool           deferred;  ///< Is the Asset unused and waiting to be released?
+        bool           reloading; ///< Is the Asset being reloaded by ReloadFile?
+        bool           pending;   ///< Is the Asset counted in mPendingAssets?
+        char           pad_[3];   ///< Padding
+        /// Load in flight for this Asset or NULL if it isn't being loaded
+        std::shared_ptr<typeLoadRequest> request;
+        /// Assets this Asset holds a reference to (see AddDependency)
+        std::vector<typeAssetDependency> dependencies;
+        /// TYPE acquired for this Asset, asset differs while sharing content
+        TYPE*          acquired;
+        /// Asset whose TYPE this Asset shares or NULL (see SetContentSharing)
+        typeAssetData* content;
+        /// Number of Assets sharing the TYPE of this Asset (see content)
+        Uint32         sharers;
+        /// Hash of the bytes this Asset is loaded from if it is registered
+        /// in the content table for others to share, 0 otherwise (see typeContent)
+        Uint64         contentHash;
+      };
+
       /**
        * TAssetHandler default constructor.
        */
       TAssetHandler() :
-        IAssetHandler(typeid(TYPE).name())
+        IAssetHandler(typeid(TYPE).name(), IAssetHandler::GetTypeIndex<TYPE>()),
+        mCacheHead(NULL),
+        mCacheTail(NULL),
+        mDeferredCount(0),
+        mResidentBytes(0),
+        mMemoryBudget(0),
+        mRetryDelay(RETRY_DELAY),
+        mRetryDelayMaximum(RETRY_DELAY_MAXIMUM),
+        mContentSharing(false),
+        mLoadNanoseconds(0),
+        mCoalescedLoads(0),
+        mSharedLoads(0),
+        mResidentBytesMaximum(0),
+        mReferenceHits(0),
+        mReferenceCreates(0),
+        mLoads(0),
+        mLoadFailures(0),
+        mLoadNanosecondsMaximum(0),
+        mPendingChunk(0),
+        mPendingAssets(0),
+        mSlotChunks(NULL),
+        mSlotDirectorySize(0),
+        mSlotChunkCount(0),
+        mAssets(0),
+        mAssetsMaximum(0)
       {
         ILOG() << "TAssetHandler::ctor(" << GetID() << ")" << std::endl;
+
+        // Nothing has been loaded yet
+        for(Uint32 anIndex = 0; anIndex < LOAD_TIME_BUCKETS; anIndex++)
+        {
+          mLoadTimes[anIndex] = 0;
+        }
       }
 
       /**
@@ -37,35 +176,99 @@ namespace GExL
       {
         ILOG() << "TAssetHandler::dtor(" << GetID() << ")" << std::endl;
 
-        // Iterator to use while deleting all assets
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Swap in or throw away any reloads still waiting for FinishReloads
+        FinishReloads();
 
-        // Loop through each asset and try to remove each one
-        iter = mAssets.begin();
-        while(iter != mAssets.end())
+        // Throw away any loads still waiting for FinalizeLoads
+        std::vector<typeAssetData*> anFinalizes;
+        {
+          std::lock_guard<std::mutex> anLock(mFinalizeMutex);
+          anFinalizes.swap(mFinalizes);
+        }
+        for(size_t anIndex = 0; anIndex < anFinalizes.size(); anIndex++)
         {
-          // Decrement the reference count for this asset
-          iter->second.count--;
+          FinishLoad(anFinalizes[anIndex], false);
+        }
 
-          // See if the asset should be released and deleted
-          if(iter->second.count != 0)
+        // Drop the references our assets hold to their dependencies, the
+        // AssetManager already did this if we were registered with one
+        ClearDependencies();
+
+        // Drop the references held to the assets whose TYPE is shared
+        std::vector<typeAssetData*> anContents;
+        for(size_t anIndex = 0; anIndex < SHARD_COUNT; anIndex++)
+        {
+          typeAssetShard& anShard = mShards[anIndex];
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          for(Uint32 anSlot = 0; anSlot < anShard.assets.capacity(); anSlot++)
           {
-            // Log an error for trying to drop a reference to an unknown ID
-            ELOG() << "TAssetHandler(" << GetID() << "):dtor("
-              << iter->first << ") Non zero asset reference count("
-              << iter->second.count << ")!" << std::endl;
+            if(anShard.assets.isUsed(anSlot) &&
+              NULL != anShard.assets.itemAt(anSlot)->content)
+            {
+              anContents.push_back(anShard.assets.itemAt(anSlot)->content);
+              anShard.assets.itemAt(anSlot)->content = NULL;
+            }
           }
-          const typeAssetID anAssetID = iter->first;
-          TYPE* anAsset = iter->second.asset;
+        }
+        for(size_t anIndex = 0; anIndex < anContents.size(); anIndex++)
+        {
+          DropContent(anContents[anIndex]);
+        }
+
+        // Loop through each shard and remove every asset it holds
+        for(size_t anIndex = 0; anIndex < SHARD_COUNT; anIndex++)
+        {
+          // The shard being emptied
+          typeAssetShard& anShard = mShards[anIndex];
+
+          // Loop through each slot and try to remove each asset found
+          for(Uint32 anSlot = 0; anSlot < anShard.assets.capacity(); anSlot++)
+          {
+            // Skip slots that don't hold an asset
+            if(false == anShard.assets.isUsed(anSlot))
+            {
+              continue;
+            }
+            typeAssetData* anAssetData = anShard.assets.itemAt(anSlot);
+
+            // Unused assets waiting in the cache or to be released are
+            // expected to be here
+            if(false == anAssetData->cached && false == anAssetData->deferred)
+            {
+              // Decrement the reference count for this asset
+              anAssetData->count--;
+
+              // See if the asset should be released and deleted
+              if(anAssetData->count != 0)
+              {
+                // Log an error for trying to drop a reference to an unknown ID
+                ELOG() << "TAssetHandler(" << GetID() << "):dtor("
+                  << anAssetData->key << ") Non zero asset reference count("
+                  << anAssetData->count << ")!" << std::endl;
+              }
+            }
 
-          // Remove this Asset Data structure from our map
-          mAssets.erase(iter++);
+            // Release the asset
+            ReleaseAsset(anAssetData->key.GetID(), anAssetData->acquired);
 
-          // Release the asset
-          ReleaseAsset(anAssetID, anAsset);
+            // Give the Asset Data structure back to our pool
+            FreeAssetData(anAssetData);
+          }
 
-          // Don't keep pointers to something that has been released
-          anAsset = NULL;
+          // Remove every Asset Data structure from our table
+          anShard.assets.clear();
+        }
+
+        // Delete every slot chunk now that no Asset Data is left in them
+        std::atomic<typeSlotChunk*>* anDirectory = mSlotChunks.load();
+        for(Uint32 anIndex = 0; anIndex < mSlotChunkCount; anIndex++)
+        {
+          delete anDirectory[anIndex].load();
+        }
+        delete[] anDirectory;
+        for(size_t anIndex = 0; anIndex < mRetiredDirectories.size(); anIndex++)
+        {
+          delete[] mRetiredDirectories[anIndex];
         }
       }
 
@@ -77,67 +280,210 @@ namespace GExL
        * @param[in] theAssetID to drop the reference for
        * @param[in] theDropTime indicates if asset is dropped when count = 0 or later
        */
-      virtual void DropReference(const typeAssetID theAssetID,
+      virtual void DropReference(const AssetKey& theAssetID,
         AssetDropTime theDropTime = AssetDropUnspecified)
       {
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
-
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Asset Data to delete once the shard lock has been given up
+        typeAssetData* anReleased = NULL;
 
-        // Found asset? decrement the count value
-        if(iter != mAssets.end())
+        // Only hold the shard lock while the table is being examined
         {
-          // Default to dropTime previously registered
-          AssetDropTime anDropTime = iter->second.dropTime;
+          // Find and lock the shard that holds theAssetID
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-          // Decrement the reference count for this asset
-          iter->second.count--;
+          // Try to find the asset using the hash of theAssetID as the key
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
-          // Caller specified another dropTime value? use it instead
-          if(AssetDropUnspecified != theDropTime &&
-            theDropTime > AssetDropUnspecified &&
-            theDropTime <= AssetDropAtExit)
+          // Found asset? decrement the count value
+          if(NULL != anAssetData)
           {
-            anDropTime = theDropTime;
+            anReleased = DropLocked(anShard, *anAssetData, theDropTime);
           }
-
-          // Use anDropTime specified above
-          switch(anDropTime)
+          else
           {
-          default:
-            ELOG() << "TAssetHandler(" << GetID() << ")::DropReference("
-              << theAssetID << ") Unknown drop time specified!" << std::endl;
-          case AssetDropUnspecified:
-          case AssetDropAtZero:
-            // See if the asset should be released and deleted
-            if(iter->second.count == 0)
-            {
-              TYPE* anAsset = iter->second.asset;
+            // Log an error for trying to drop a reference to an unknown ID
+            ELOG() << "TAssetHandler(" << GetID() << "):DropReference("
+              << theAssetID << ") Asset ID not found!"
+              << std::endl;
+          }
+        }
 
-              // Remove this Asset Data structure from our map
-              mAssets.erase(iter++);
+        // Release the asset outside of the shard lock
+        DeleteAssetData(anReleased);
 
-              // Release the asset
-              ReleaseAsset(theAssetID, anAsset);
+        // The asset might have been added to the cache instead
+        CheckMemoryBudget();
+      }
 
-              // Don't keep pointers to something that has been released
-              anAsset = NULL;
-            }
-            break;
-          case AssetDropAtExit:
-            /* Do nothing, destructor will release each asset */
-            break;
+      /**
+       * DropReference will decrement the reference counter of theAssetData
+       * previously returned by AcquireReference. While other references
+       * remain this is a single atomic decrement, only the final reference
+       * takes the shard lock to remove and release the asset.
+       * @param[in] theAssetData to drop the reference for
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or later
+       */
+      void DropReference(typeAssetData* theAssetData,
+        AssetDropTime theDropTime = AssetDropUnspecified)
+      {
+        // Asset Data to delete once the shard lock has been given up
+        typeAssetData* anReleased = NULL;
+
+        // Not the last reference? then just decrement the count
+        Uint32 anCount = theAssetData->count.load(std::memory_order_relaxed);
+        while(anCount > 1)
+        {
+          if(theAssetData->count.compare_exchange_weak(anCount, anCount - 1,
+            std::memory_order_acq_rel))
+          {
+            return;
           }
         }
-        else
+
+        // Possibly the last reference, decrement it under the shard lock so
+        // GetReference can't find the asset while it is being removed
         {
-          // Log an error for trying to drop a reference to an unknown ID
-          ELOG() << "TAssetHandler(" << GetID() << "):DropReference("
-            << theAssetID << ") Asset ID not found!"
-            << std::endl;
+          typeAssetShard& anShard = GetShard(theAssetData->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          anReleased = DropLocked(anShard, *theAssetData, theDropTime);
+        }
+
+        // Release the asset outside of the shard lock
+        DeleteAssetData(anReleased);
+
+        // The asset might have been added to the cache instead
+        CheckMemoryBudget();
+      }
+
+      /**
+       * IsRetryPending will return true if the last load of theAssetData
+       * failed and its retry delay has not passed yet. This only reads an
+       * atomic so TAsset can call it on every GetAsset without any locks.
+       * @param[in] theAssetData to check
+       * @return true if theAssetData should not be loaded yet, false otherwise
+       */
+      bool IsRetryPending(const typeAssetData* theAssetData) const
+      {
+        const Uint64 anRetryTime = theAssetData->retryTime.load(std::memory_order_relaxed);
+        return 0 != anRetryTime && (RETRY_NEVER == anRetryTime ||
+          GetSteadyTime() < anRetryTime);
+      }
+
+      /**
+       * AddReference will increment the reference counter of theAssetData
+       * previously returned by AcquireReference using a single atomic
+       * increment. The caller must already hold a reference to theAssetData.
+       * @param[in] theAssetData to add a reference to
+       */
+      void AddReference(typeAssetData* theAssetData)
+      {
+        theAssetData->count.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      /**
+       * GetHandle will return the generational handle of theAssetData. The
+       * handle doesn't hold a reference, once theAssetData is released the
+       * handle becomes stale and is rejected by IsHandleValid and
+       * AcquireHandle even if its slot is reused.
+       * @param[in] theAssetData to get the handle of
+       * @return the handle or INVALID_HANDLE if theAssetData is NULL
+       */
+      typeAssetHandle GetHandle(const typeAssetData* theAssetData) const
+      {
+        if(NULL == theAssetData)
+        {
+          return INVALID_HANDLE;
+        }
+        const Uint32 anGeneration = GetSlotChunk(theAssetData->slot).generations[
+          theAssetData->slot % POOL_CHUNK_SIZE].load(std::memory_order_acquire);
+        return (typeAssetHandle(anGeneration) << 32) | theAssetData->slot;
+      }
+
+      /**
+       * IsHandleValid will return true if theHandle still refers to an asset
+       * registered with this handler. This is only a few loads, no lock is
+       * taken.
+       * @param[in] theHandle to check
+       * @return true if theHandle isn't stale, false otherwise
+       */
+      bool IsHandleValid(typeAssetHandle theHandle) const
+      {
+        const Uint32 anSlot = Uint32(theHandle & 0xFFFFFFFFULL);
+        const Uint32 anGeneration = Uint32(theHandle >> 32);
+
+        // Even generations never refer to Asset Data
+        if(0 == (anGeneration & 1) || anSlot / POOL_CHUNK_SIZE >=
+          mSlotChunkCount.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+        return anGeneration == GetSlotChunk(anSlot).generations[
+          anSlot % POOL_CHUNK_SIZE].load(std::memory_order_acquire);
+      }
+
+      /**
+       * AcquireHandle will increment the reference counter of the asset
+       * theHandle refers to. Each successful call must be matched by
+       * DropReference.
+       * @param[in] theHandle of the asset to reference
+       * @return the Asset Data referenced or NULL if theHandle is stale
+       */
+      typeAssetData* AcquireHandle(typeAssetHandle theHandle)
+      {
+        // The chunk of a valid handle exists and belongs to one shard
+        if(false == IsHandleValid(theHandle))
+        {
+          return NULL;
+        }
+        const Uint32 anSlot = Uint32(theHandle & 0xFFFFFFFFULL);
+        typeSlotChunk& anChunk = GetSlotChunk(anSlot);
+
+        // The slot can't be emptied or filled while we hold its shard lock
+        typeAssetShard& anShard = mShards[anChunk.shard];
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+        if(false == IsHandleValid(theHandle))
+        {
+          return NULL;
         }
+
+        // Only Asset Data still in its shard table can be referenced, a
+        // slot is emptied after its Asset Data was removed from the table
+        typeAssetData* anResult = reinterpret_cast<typeAssetData*>(
+          anChunk.records[anSlot % POOL_CHUNK_SIZE].bytes);
+        if(anResult != FindAsset(anShard, anResult->key))
+        {
+          return NULL;
+        }
+
+        // Increment the reference count, taking it back out of the cache or
+        // the release queue if it was unused
+        if(0 == anResult->count++)
+        {
+          Revive(*anResult);
+        }
+        mReferenceHits++;
+        return anResult;
+      }
+
+      /**
+       * AddReference will increment the reference counter for theAssetID
+       * specified, acquiring the asset without loading it if it doesn't exist
+       * yet. Used by AssetManager::LoadGroup which doesn't know the asset
+       * TYPE of each handler. Each call must be matched by DropReference.
+       * @param[in] theAssetID to add the reference for
+       * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or exit
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
+       * @return true if the reference was added, false otherwise
+       */
+      virtual bool AddReference(const AssetKey& theAssetID,
+        AssetLoadStyle theLoadStyle = AssetLoadFromFile,
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible)
+      {
+        return NULL != AcquireReference(theAssetID, AssetLoadLater,
+          theLoadStyle, theDropTime, thePriority);
       }
 
       /**
@@ -158,88 +504,196 @@ namespace GExL
        * AcquireAsset pure virtual function to obtain it if it hasn't yet been
        * created.
        * @param[in] theAssetID to lookup for the reference
-       * @param[in] theLoadTime (Now, Later) of when to load this asset
+       * @param[in] theLoadTime (Now, Later, Async) of when to load this asset
        * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
        * @param[in] theDropTime indicates if asset is dropped when count = 0 or exit
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
        * @return the asset found or a newly acquired asset if not found
        */
-      TYPE* GetReference(const typeAssetID theAssetID,
+      TYPE* GetReference(const AssetKey& theAssetID,
+        AssetLoadTime theLoadTime = AssetLoadLater,
+        AssetLoadStyle theLoadStyle = AssetLoadFromFile,
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible)
+      {
+        // Asset Data found or acquired for theAssetID
+        typeAssetData* anAssetData = AcquireReference(theAssetID, theLoadTime,
+          theLoadStyle, theDropTime, thePriority);
+
+        // Return the asset found or the Dummy Asset if it couldn't be acquired
+        return (NULL != anAssetData) ? anAssetData->asset.load() : &mDummyAsset;
+      }
+
+      /**
+       * AcquireReference will retrieve the Asset Data registered under
+       * theAssetID and increment the reference counter for this asset or call
+       * the AcquireAsset pure virtual function to obtain it if it hasn't yet
+       * been created. The Asset Data returned stays at the same address until
+       * the last reference is dropped so it can be used with AddReference and
+       * DropReference without looking theAssetID up again. The priority of
+       * an asset already being loaded is raised to thePriority if it is higher.
+       * @param[in] theAssetID to lookup for the reference
+       * @param[in] theLoadTime (Now, Later, Async) of when to load this asset
+       * @param[in] theLoadStyle (File, Mem, Network) to use when loading this asset
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or exit
+       * @param[in] thePriority (Prefetch, Visible, Critical) of loading this asset
+       * @return the Asset Data found or acquired, NULL if it couldn't be acquired
+       */
+      typeAssetData* AcquireReference(const AssetKey& theAssetID,
         AssetLoadTime theLoadTime = AssetLoadLater,
         AssetLoadStyle theLoadStyle = AssetLoadFromFile,
-        AssetDropTime theDropTime = AssetDropAtZero)
+        AssetDropTime theDropTime = AssetDropAtZero,
+        AssetLoadPriority thePriority = AssetLoadVisible)
       {
-        // IAsset pointer that will be returned
-        TYPE* anResult = NULL;
+        // Asset Data that will be returned
+        typeAssetData* anResult = NULL;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // When should the newly acquired asset be loaded?
+        AssetLoadTime anLoadTime = AssetLoadLater;
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Task to queue if the priority of a load in flight was raised
+        AssetLoader::typeLoadTask anRaised;
 
-        // Found asset? increment the count and return the reference
-        if(iter != mAssets.end())
-        {
-          // Increment the reference count for this asset
-          iter->second.count++;
+        // Asset to release if no Asset Data could be allocated for it
+        TYPE* anUnused = NULL;
 
-          // Return the IAsset address found
-          anResult = iter->second.asset;
-        }
-        else
+        // Only hold the shard lock while the table is being examined
         {
-          // First attempt to acquire the asset first
-          anResult = AcquireAsset(theAssetID);
+          // Find and lock the shard that holds theAssetID
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          // Try to find the asset using the hash of theAssetID as the key
+          anResult = FindAsset(anShard, theAssetID);
 
-          // Map the newly acquired asset to theAssetID provided
+          // Found asset? increment the count and return the reference
           if(NULL != anResult)
           {
-            // Create a new AssetData to hold our asset information
-            typeAssetData anAssetData;
+            // Increment the reference count for this asset, taking it back
+            // out of the cache or the release queue if it was unused
+            if(0 == anResult->count++)
+            {
+              Revive(*anResult);
+            }
+            mReferenceHits++;
+
+            // Load it sooner if we need it more urgently than before
+            RaiseLocked(*anResult, thePriority, anRaised);
+          }
+          else
+          {
+            // Show the creation of the asset on the timeline of this thread
+            AssetTrace::Scope anTrace("AcquireAsset", typeid(TYPE).name(),
+              theAssetID);
 
-            // Acquire the asset for the first time
-            anAssetData.asset = anResult;
-            anAssetData.count = 1;
-            anAssetData.loaded = false;
-            anAssetData.loadStyle = theLoadStyle;
-            anAssetData.loadTime = theLoadTime;
-            anAssetData.dropTime = AssetDropAtZero;
-            anAssetData.filename = theAssetID;
+            // First attempt to acquire the asset first
+            TYPE* anAsset = AcquireAsset(theAssetID.GetID());
 
-            // Check the Load Style range provided and force to LoadFromUnknown if out of range
-            if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
+            // Create a new AssetData to hold our asset information
+            if(NULL != anAsset)
             {
-              // Force style to AssetLoadFromFile if out of enum range
-              anAssetData.loadStyle = AssetLoadFromFile;
+              anResult = AllocateAssetData(anShard, theAssetID);
+              if(NULL == anResult)
+              {
+                anUnused = anAsset;
+              }
             }
 
-            // Check the Load Time range provided and force LoadNow if out of range
-            if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadLater)
+            // Map the newly acquired asset to theAssetID provided
+            if(NULL != anResult)
             {
-              // Force load time to AssetLoadLater if out of enum range
-              anAssetData.loadTime = AssetLoadLater;
+              // Acquire the asset for the first time
+              anResult->asset = anAsset;
+              anResult->acquired = anAsset;
+              anResult->content = NULL;
+              anResult->sharers = 0;
+              anResult->contentHash = 0;
+              anResult->count = 1;
+              anResult->loaded = false;
+              anResult->loadStyle = theLoadStyle;
+              anResult->loadTime = theLoadTime;
+              anResult->dropTime = theDropTime;
+              anResult->priority = thePriority;
+              anResult->size = 0;
+              anResult->cachePrev = NULL;
+              anResult->cacheNext = NULL;
+              anResult->cached = false;
+              anResult->deferred = false;
+              anResult->reloading = false;
+              anResult->pending = false;
+              anResult->retryTime = 0;
+
+              // Check the Load Style range provided and force to LoadFromUnknown if out of range
+              if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
+              {
+                // Force style to AssetLoadFromFile if out of enum range
+                anResult->loadStyle = AssetLoadFromFile;
+              }
+
+              // Check the Load Time range provided and force LoadNow if out of range
+              if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadAsync)
+              {
+                // Force load time to AssetLoadLater if out of enum range
+                anResult->loadTime = AssetLoadLater;
+              }
+
+              // Check the Priority range provided and force Visible if out of range
+              if(thePriority < AssetLoadPrefetch || thePriority > AssetLoadCritical)
+              {
+                anResult->priority = AssetLoadVisible;
+              }
+
+              // Check the Drop Time range provided and force AtZero if out of range
+              if(theDropTime <= AssetDropUnspecified || theDropTime > AssetDropDeferred)
+              {
+                // Force drop time to AssetDropAtZero if out of enum range
+                anResult->dropTime = AssetDropAtZero;
+              }
+
+              // Count the asset if it waits for LoadPendingAssets
+              UpdatePending(*anResult);
+
+              // Store the newly acquired asset pointer in our table for future reference
+              anShard.assets.insert(theAssetID.GetHash(), anResult);
+              mReferenceCreates++;
+
+              // Remember when we were asked to load the asset
+              anLoadTime = anResult->loadTime;
             }
-
-            // Store the newly acquired asset pointer in our map for future reference
-            mAssets.insert(std::pair<const typeAssetID, typeAssetData>(theAssetID, anAssetData));
-
-            // Were we asked to load the asset now?
-            if(AssetLoadNow == anAssetData.loadTime)
+            else
             {
-              // Load the Asset now
-              LoadAsset(theAssetID);
+              // Callers holding NULL get the dummy asset, make sure it shows
+              ELOG() << "TAssetHandler(" << GetID() << "):AcquireReference("
+                << theAssetID << ") unable to create the asset, out of memory!"
+                << std::endl;
             }
           }
         }
 
-        // If result is NULL by this point then return the Dummy Asset instead
-        if(NULL == anResult)
+        // Release the asset we couldn't keep without holding the shard lock
+        if(NULL != anUnused)
         {
-          // Get the DummyAsset pointer now
-          anResult = &mDummyAsset;
+          ReleaseAsset(theAssetID.GetID(), anUnused);
         }
 
-        // Return the asset pointer provided to the caller
+        // Queue the load we raised the priority of again at its new priority
+        if(anRaised)
+        {
+          AddLoadTask(anRaised, thePriority);
+        }
+
+        // Load the Asset now, our reference keeps it alive without the lock
+        if(AssetLoadNow == anLoadTime)
+        {
+          LoadAsset(theAssetID);
+        }
+        // Or start loading the Asset on one of the loader threads
+        else if(AssetLoadAsync == anLoadTime)
+        {
+          LoadAssetAsync(theAssetID);
+        }
+
+        // Return the Asset Data to the caller
         return anResult;
       }
 
@@ -249,22 +703,23 @@ namespace GExL
        * @param[in] theAssetID to the Resource to determine loaded state
        * @return true if loaded, false otherwise
        */
-      virtual bool IsLoaded(const typeAssetID theAssetID) const
+      virtual bool IsLoaded(const AssetKey& theAssetID) const
       {
         // Result if asset was not found
         bool anResult = false;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::const_iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Return the loaded value found
-          anResult = iter->second.loaded;
+          anResult = anAssetData->loaded;
         }
         else
         {
@@ -278,28 +733,58 @@ namespace GExL
         return anResult;
       }
 
+      /**
+       * IsLoading will return true if the Resource specified by theAssetID is
+       * currently being loaded by some thread.
+       * @param[in] theAssetID to the Resource to determine loading state
+       * @return true if a load is in flight, false otherwise
+       */
+      virtual bool IsLoading(const AssetKey& theAssetID) const
+      {
+        // Result if asset was not found
+        bool anResult = false;
+
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+
+        // Found asset? a load request means a load is in flight
+        if(NULL != anAssetData)
+        {
+          anResult = (NULL != anAssetData->request);
+        }
+
+        // Return the result found or the default result assigned above
+        return anResult;
+      }
+
       /**
        * GetFilename is responsible for retrieving the filename to use when
        * loading theAssetID specified.
        * @param[in] theAssetID to set filename for
        * @return std::string filename for theAssetID provided
        */
-      virtual const std::string GetFilename(const typeAssetID theAssetID) const
+      virtual const std::string GetFilename(const AssetKey& theAssetID) const
       {
         // Return empty string if no filename was found
         std::string anResult;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::const_iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the filename found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
-          // Retrieve the filename for this asset
-          anResult = iter->second.filename;
+          // Retrieve the filename for this asset, the asset ID if none was set
+          anResult = anAssetData->filename.empty() ?
+            anAssetData->key.GetID() : anAssetData->filename;
         }
         else
         {
@@ -319,26 +804,35 @@ namespace GExL
        * @param[in] theAssetID to set filename for
        * @param[in] theFilename to use when loading this asset from a file
        */
-      virtual void SetFilename(const typeAssetID theAssetID, std::string theFilename)
+      virtual void SetFilename(const AssetKey& theAssetID, std::string theFilename)
       {
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Print warning if asset has already been loaded
-          if(false == iter->second.loaded)
+          if(false == anAssetData->loaded)
           {
             WLOG() << "TAssetHandler(" << GetID() << ")::SetFilename("
               << theAssetID << ") Asset is already loaded" << std::endl;
           }
 
-          // Set the filename for this asset
-          iter->second.filename = theFilename;
+          // Set the filename for this asset, only keep a copy if it differs
+          // from the asset ID since GetFilename falls back to the asset ID
+          if(theFilename == anAssetData->key.GetID())
+          {
+            anAssetData->filename.clear();
+          }
+          else
+          {
+            anAssetData->filename = theFilename;
+          }
         }
         else
         {
@@ -349,26 +843,83 @@ namespace GExL
         }
       }
 
+      /**
+       * SetMemorySource is responsible for noting theSize bytes at theData
+       * to hand to LoadFromMemory when theAssetID is loaded using the
+       * AssetLoadFromMemory style. No bytes are copied, so theData must stay
+       * valid until the source is cleared and every asset loaded from it
+       * has been released. Without a memory source the mounted asset packs
+       * are searched instead (see AssetManager::MountPack).
+       * @param[in] theAssetID to set the memory source for
+       * @param[in] theData to load theAssetID from
+       * @param[in] theSize number of bytes at theData
+       */
+      void SetMemorySource(const AssetKey& theAssetID, const void* theData,
+        Uint64 theSize)
+      {
+        typeMemorySource anSource;
+        anSource.data = AssetSpan(static_cast<const Uint8*>(theData), theSize);
+        StoreMemorySource(theAssetID, anSource);
+      }
+
+      /**
+       * SetMemorySource is responsible for noting theBuffer to hand to
+       * LoadFromMemory when theAssetID is loaded using the
+       * AssetLoadFromMemory style. The handler shares ownership of theBuffer
+       * until the source is replaced or cleared and loads in flight keep
+       * their own reference.
+       * @param[in] theAssetID to set the memory source for
+       * @param[in] theBuffer to load theAssetID from
+       */
+      void SetMemorySource(const AssetKey& theAssetID,
+        std::shared_ptr<const std::vector<Uint8> > theBuffer)
+      {
+        typeMemorySource anSource;
+        if(NULL != theBuffer && false == theBuffer->empty())
+        {
+          anSource.data = AssetSpan(&(*theBuffer)[0], theBuffer->size());
+        }
+        anSource.buffer = theBuffer;
+        StoreMemorySource(theAssetID, anSource);
+      }
+
+      /**
+       * ClearMemorySource is responsible for forgetting the memory source
+       * previously set for theAssetID. Assets already loaded from it are not
+       * affected.
+       * @param[in] theAssetID to clear the memory source for
+       */
+      void ClearMemorySource(const AssetKey& theAssetID)
+      {
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        // Forget the source, releasing our share of any buffer
+        anShard.sources.remove(theAssetID.GetHash());
+      }
+
       /**
        * GetLoadStyle allows someone to find out the loading style of
        * theAssetID provided.
        * @param[in] theAssetID of the asset to find loading style for
        * @return the loading style for the asset or LoadFromUnknown otherwise
        */
-      virtual AssetLoadStyle GetLoadStyle(const typeAssetID theAssetID) const
+      virtual AssetLoadStyle GetLoadStyle(const AssetKey& theAssetID) const
       {
         AssetLoadStyle anResult = AssetLoadFromUnknown;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::const_iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Retrieve our loading style from the asset found
-          anResult = iter->second.loadStyle;
+          anResult = anAssetData->loadStyle;
         }
         else
         {
@@ -389,31 +940,32 @@ namespace GExL
        * @param[in] theAssetID of the asset to change loading style
        * @param[in] theLoadStyle (File,Mem,Network) to use when loading this asset
        */
-      void SetLoadStyle(const typeAssetID theAssetID, AssetLoadStyle theLoadStyle)
+      void SetLoadStyle(const AssetKey& theAssetID, AssetLoadStyle theLoadStyle)
       {
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Check the range provided and force to Unknown if out of range
           if(theLoadStyle < AssetLoadFromUnknown || theLoadStyle > AssetLoadFromNetwork)
           {
             // Force style to AssetLoadFromFile if out of enum range
-            iter->second.loadStyle = AssetLoadFromFile;
+            anAssetData->loadStyle = AssetLoadFromFile;
           }
           else
           {
             // Set the asset Load Style now
-            iter->second.loadStyle = theLoadStyle;
+            anAssetData->loadStyle = theLoadStyle;
           }
 
           // Are we changing the load style after it was loaded!?
-          if(true == iter->second.loaded)
+          if(true == anAssetData->loaded)
           {
             switch(theLoadStyle)
             {
@@ -452,20 +1004,21 @@ namespace GExL
        * @param[in] theAssetID of the asset to find loading time for
        * @return the loading time for the asset or AssetLoadLater otherwise
        */
-      virtual AssetLoadTime GetLoadTime(const typeAssetID theAssetID) const
+      virtual AssetLoadTime GetLoadTime(const AssetKey& theAssetID) const
       {
         AssetLoadTime anResult = AssetLoadLater;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::const_iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Retrieve our loading time from the asset found
-          anResult = iter->second.loadTime;
+          anResult = anAssetData->loadTime;
         }
         else
         {
@@ -486,31 +1039,33 @@ namespace GExL
        * @param[in] theAssetID of the asset to change loading time
        * @param[in] theLoadTime (Now,Later) of when to load this asset
        */
-      virtual void SetLoadTime(const typeAssetID theAssetID, AssetLoadTime theLoadTime)
+      virtual void SetLoadTime(const AssetKey& theAssetID, AssetLoadTime theLoadTime)
       {
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Check the range provided and force to Unknown if out of range
-          if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadLater)
+          if(theLoadTime < AssetLoadNow || theLoadTime > AssetLoadAsync)
           {
             // Force load time to AssetLoadLater if out of enum range
-            iter->second.loadTime = AssetLoadLater;
+            anAssetData->loadTime = AssetLoadLater;
           }
           else
           {
             // Set the asset Load Time now
-            iter->second.loadTime = theLoadTime;
+            anAssetData->loadTime = theLoadTime;
           }
+          UpdatePending(*anAssetData);
 
           // Are we changing the load time after it was loaded!?
-          if(true == iter->second.loaded)
+          if(true == anAssetData->loaded)
           {
             switch(theLoadTime)
             {
@@ -522,6 +1077,10 @@ namespace GExL
               WLOG() << "TAssetHandler(" << GetID() << ")::SetLoadTime("
                 << theAssetID << ") Setting load time to later" << std::endl;
               break;
+            case AssetLoadAsync:
+              WLOG() << "TAssetHandler(" << GetID() << ")::SetLoadTime("
+                << theAssetID << ") Setting load time to async" << std::endl;
+              break;
             default:
               WLOG() << "TAssetHandler(" << GetID() << ")::SetLoadTime("
                 << theAssetID << ") Setting load time to unknown!" << std::endl;
@@ -544,20 +1103,21 @@ namespace GExL
        * @param[in] theAssetID of the asset to find drop time for
        * @return the drop time for the asset or AssetDropUnspecified otherwise
        */
-      virtual AssetDropTime GetDropTime(const typeAssetID theAssetID) const
+      virtual AssetDropTime GetDropTime(const AssetKey& theAssetID) const
       {
         AssetDropTime anResult = AssetDropUnspecified;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::const_iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Retrieve our loading time from the asset found
-          anResult = iter->second.dropTime;
+          anResult = anAssetData->dropTime;
         }
         else
         {
@@ -575,30 +1135,31 @@ namespace GExL
        * SetDropTime allows someone to change the drop time of theAssetID
        * provided.
        * @param[in] theAssetID of the asset to change loading time
-       * @param[in] theDropTime (Zero, Exit) of when to drop this asset
+       * @param[in] theDropTime (Zero, Exit, LRU, Deferred) of when to drop this asset
        */
-      virtual void SetDropTime(const typeAssetID theAssetID,
+      virtual void SetDropTime(const AssetKey& theAssetID,
         AssetDropTime theDropTime)
       {
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Try to find the asset using the hash of theAssetID as the key
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
 
         // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        if(NULL != anAssetData)
         {
           // Check the range provided and force to Unknown if out of range
-          if(theDropTime < AssetDropAtZero || theDropTime > AssetDropAtExit)
+          if(theDropTime < AssetDropAtZero || theDropTime > AssetDropDeferred)
           {
             // Force drop time to AssetDropAtZero if out of enum range
-            iter->second.dropTime = AssetDropAtZero;
+            anAssetData->dropTime = AssetDropAtZero;
           }
           else
           {
             // Set the asset drop time now
-            iter->second.dropTime = theDropTime;
+            anAssetData->dropTime = theDropTime;
           }
         }
         else
@@ -613,55 +1174,104 @@ namespace GExL
       /**
        * LoadAsset is responsible for loading the asset specified by theAssetID
        * provided according to the previously registered style (see
-       * GetReference and SetLoadStyle).
+       * GetReference and SetLoadStyle). The shard lock is not held while the
+       * asset is being loaded, instead the asset is marked as loading and a
+       * reference is held until the load completes. If theAssetID is
+       * already being loaded only one load is ever run: a load still waiting
+       * for a loader thread is taken over and run on this thread, otherwise
+       * the caller waits for the result of the load in flight (finalizing
+       * loads while waiting if this is the thread that finalizes them, see
+       * IsFinalizeThread). Each caller
+       * that joins a load in flight is counted by GetCoalescedLoads.
        * @param[in] theAssetID of the asset to load
        * @return bool true if theAssetID was found and loaded, false otherwise
        */
-      virtual bool LoadAsset(const typeAssetID theAssetID)
+      virtual bool LoadAsset(const AssetKey& theAssetID)
       {
         // Result if asset was not found
         bool anResult = false;
 
-        // Iterator to the asset if found
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Asset Data claimed and loading style to use once the shard lock is released
+        typeAssetData* anClaimed = NULL;
+        AssetLoadStyle anLoadStyle = AssetLoadFromUnknown;
 
-        // Try to find the asset using theAssetID as the key
-        iter = mAssets.find(theAssetID);
+        // Load in flight to wait for once the shard lock is released
+        std::shared_future<bool> anInFlight;
 
-        // Found asset? return the loaded indicator found
-        if(iter != mAssets.end())
+        // Only hold the shard lock while the map is being examined
         {
-          if(false == iter->second.loaded)
+          // Find and lock the shard that holds theAssetID
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          // Try to find the asset using the hash of theAssetID as the key
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+
+          // Found asset? return the loaded indicator found
+          if(NULL != anAssetData)
           {
-            // Attempt to load the asset now using the correct style
-            switch(iter->second.loadStyle)
+            // Claim the load if nobody else has loaded or is loading this
+            // asset and it didn't fail to load too recently
+            if(false == anAssetData->loaded && NULL == anAssetData->request &&
+              false == IsRetryPending(anAssetData))
             {
-            case AssetLoadFromFile:
-              iter->second.loaded = LoadFromFile(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromMemory:
-              iter->second.loaded = LoadFromMemory(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromNetwork:
-              iter->second.loaded = LoadFromNetwork(theAssetID, *(iter->second.asset));
-              break;
-            case AssetLoadFromUnknown:
-            default:
-              ELOG() << "TAssetHandler(" << GetID() << ")::LoadAsset("
-                << theAssetID << ") unknown loading style specified!" << std::endl;
-              break;
+              ClaimLoad(*anAssetData, typeAssetLoadCallback());
+              anAssetData->request->started = true;
+              anClaimed = anAssetData;
+              anLoadStyle = anAssetData->loadStyle;
             }
+            else if(NULL != anAssetData->request)
+            {
+              // Join the load in flight, running it here if no loader
+              // thread has started it yet (see RunLoad)
+              mCoalescedLoads++;
+              if(false == anAssetData->request->started.exchange(true))
+              {
+                anClaimed = anAssetData;
+                anLoadStyle = anAssetData->loadStyle;
+              }
+              else
+              {
+                anInFlight = anAssetData->request->future;
+              }
+            }
+
+            // Set our return result
+            anResult = anAssetData->loaded;
+          }
+          else
+          {
+            // Log a warning for trying to determine loaded value of an unknown asset ID
+            WLOG() << "TAssetHandler(" << GetID() << "):LoadAsset("
+              << theAssetID << ") Asset ID provided not found!"
+              << std::endl;
           }
+        }
 
-          // Set our return result
-          anResult = iter->second.loaded;
+        // Did we claim the load above? then load and finalize it on this
+        // thread without holding the lock
+        if(NULL != anClaimed)
+        {
+          anResult = LoadContent(*anClaimed, anLoadStyle);
+          if(anResult && NeedsFinalize() && NULL == anClaimed->content)
+          {
+            anResult = Finalize(theAssetID, *anClaimed->asset);
+          }
+          FinishLoad(anClaimed, anResult);
         }
-        else
+        // Another thread is loading it? then wait for its result
+        else if(anInFlight.valid())
         {
-          // Log a warning for trying to determine loaded value of an unknown asset ID
-          WLOG() << "TAssetHandler(" << GetID() << "):LoadAsset("
-            << theAssetID << ") Asset ID provided not found!"
-            << std::endl;
+          // The load may be waiting for us to finalize it
+          if(NeedsFinalize() && IsFinalizeThread())
+          {
+            while(std::future_status::ready !=
+              anInFlight.wait_for(std::chrono::milliseconds(1)))
+            {
+              FinalizeLoads();
+            }
+          }
+          anResult = anInFlight.get();
         }
 
         // Return anResult which is true if asset was loaded, false otherwise
@@ -669,137 +1279,2556 @@ namespace GExL
       }
 
       /**
-       * LoadAllAssets is responsible for loading all unloaded assets that are
-       * currently registered with this IAssetHandler derived class.
-       * @return true if all assets were successfully loaded, false otherwise
+       * LoadAssetAsync is responsible for loading the asset specified by
+       * theAssetID on one of the AssetManager loader threads. If the asset is
+       * already being loaded then theCallback is added to the load in flight.
+       * The asset is loaded on the calling thread if this handler hasn't been
+       * registered with an AssetManager.
+       * @param[in] theAssetID of the asset to load
+       * @param[in] theCallback to call on the loader thread once the load completes
+       * @return future that will hold true if the asset was loaded, false otherwise
        */
-      virtual bool LoadAllAssets(void)
+      virtual std::shared_future<bool> LoadAssetAsync(const AssetKey& theAssetID,
+        typeAssetLoadCallback theCallback = typeAssetLoadCallback())
       {
-        // Return true if all assets load successfully
-        bool anResult = true;
-    
-        // Iterator for each typeAssetData registered
-        typename std::map<const typeAssetID, typeAssetData>::iterator iter;
+        // Future to return to the caller
+        std::shared_future<bool> anResult;
+
+        // Result to report right away if the asset doesn't need loading
+        bool anLoaded = false;
 
-        // Loop through each asset handler and tell it to load its assets
-        iter = mAssets.begin();
-        while(iter != mAssets.end())
+        // Asset Data claimed, loading style and priority to use once the
+        // shard lock is released
+        typeAssetData* anClaimed = NULL;
+        AssetLoadStyle anLoadStyle = AssetLoadFromUnknown;
+        AssetLoadPriority anPriority = AssetLoadVisible;
+        std::shared_ptr<typeLoadRequest> anRequest;
+
+        // Only hold the shard lock while the map is being examined
         {
-          // Is this an asset that hasn't been loaded yet? load it now
-          if(false == iter->second.loaded)
+          // Find and lock the shard that holds theAssetID
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          // Try to find the asset using the hash of theAssetID as the key
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+
+          // Found asset? then join or start a load
+          if(NULL != anAssetData)
           {
-            // Attempt to load the asset now using the correct style
-            switch(iter->second.loadStyle)
+            if(NULL != anAssetData->request)
             {
-            case AssetLoadFromFile:
-              iter->second.loaded = LoadFromFile(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromMemory:
-              iter->second.loaded = LoadFromMemory(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromNetwork:
-              iter->second.loaded = LoadFromNetwork(iter->first, *(iter->second.asset));
-              break;
-            case AssetLoadFromUnknown:
-            default:
-              ELOG() << "TAssetHandler(" << GetID() << ")::LoadAllAssets("
-                << iter->first << ") unknown loading style specified!" << std::endl;
-              break;
+              // Join the load already in flight
+              mCoalescedLoads++;
+              if(theCallback)
+              {
+                anAssetData->request->callbacks.push_back(theCallback);
+              }
+              anResult = anAssetData->request->future;
+            }
+            else if(false == anAssetData->loaded && false == IsRetryPending(anAssetData))
+            {
+              // Claim the load for one of the loader threads
+              anResult = ClaimLoad(*anAssetData, theCallback);
+              anClaimed = anAssetData;
+              anLoadStyle = anAssetData->loadStyle;
+              anPriority = anAssetData->priority;
+              anRequest = anAssetData->request;
+            }
+            else
+            {
+              // Already loaded or failed too recently to load again
+              anLoaded = anAssetData->loaded;
             }
           }
-
-          // Set our return result
-          anResult &= iter->second.loaded;
-
-          // Move to the next registered Assets value
-          iter++;
+          else
+          {
+            // Log a warning for trying to load an unknown asset ID
+            WLOG() << "TAssetHandler(" << GetID() << "):LoadAssetAsync("
+              << theAssetID << ") Asset ID provided not found!"
+              << std::endl;
+          }
         }
 
-        // Return anResult which will still be true if all LoadAllAssets returned
-        // true or there are no registered Assets, false otherwise
-        return anResult;
-      }
+        if(NULL != anClaimed)
+        {
+          // Load and publish the asset on one of the loader threads
+          AssetLoader::typeLoadTask anTask = std::bind(&TAssetHandler<TYPE>::RunLoad,
+            this, anClaimed, anLoadStyle, anRequest);
+
+          // Not registered with an AssetManager? then load it right now
+          if(false == AddLoadTask(anTask, anPriority))
+          {
+            anTask();
+          }
+        }
+        else if(false == anResult.valid())
+        {
+          // Nothing to wait for, report the current loaded state right away
+          std::promise<bool> anPromise;
+          anPromise.set_value(anLoaded);
+          anResult = anPromise.get_future().share();
+          if(theCallback)
+          {
+            theCallback(theAssetID.GetID(), anLoaded);
+          }
+        }
+
+        // Return the future for the load
+        return anResult;
+      }
+
+      /**
+       * RaisePriority is responsible for raising the priority of the load of
+       * theAssetID to thePriority if it is still waiting for a loader thread.
+       * Loads are never lowered to a lesser priority.
+       * @param[in] theAssetID of the asset to raise the priority of
+       * @param[in] thePriority (Prefetch, Visible, Critical) to raise it to
+       */
+      virtual void RaisePriority(const AssetKey& theAssetID,
+        AssetLoadPriority thePriority)
+      {
+        // Task to queue if the priority of a load in flight was raised
+        AssetLoader::typeLoadTask anRaised;
+        {
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+          if(NULL != anAssetData)
+          {
+            RaiseLocked(*anAssetData, thePriority, anRaised);
+          }
+        }
+
+        // Queue the load again at its new priority
+        if(anRaised)
+        {
+          AddLoadTask(anRaised, thePriority);
+        }
+      }
+
+      /**
+       * RaisePriority is responsible for raising the priority of the load of
+       * theAssetData previously returned by AcquireReference, typically
+       * because TAsset::GetAsset needs it while it is still being loaded.
+       * @param[in] theAssetData to raise the priority of
+       * @param[in] thePriority (Prefetch, Visible, Critical) to raise it to
+       */
+      void RaisePriority(typeAssetData* theAssetData, AssetLoadPriority thePriority)
+      {
+        // Task to queue if the priority of a load in flight was raised
+        AssetLoader::typeLoadTask anRaised;
+        {
+          typeAssetShard& anShard = GetShard(theAssetData->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          RaiseLocked(*theAssetData, thePriority, anRaised);
+        }
+
+        // Queue the load again at its new priority
+        if(anRaised)
+        {
+          AddLoadTask(anRaised, thePriority);
+        }
+      }
+
+      /**
+       * LoadAllAssets is responsible for loading all unloaded assets that are
+       * currently registered with this IAssetHandler derived class.
+       * @return true if all assets were successfully loaded, false otherwise
+       */
+      virtual bool LoadAllAssets(void)
+      {
+        // Show the whole batch on the timeline of this thread
+        AssetTrace::Scope anTrace("LoadAllAssets", typeid(TYPE).name());
+
+        // Return true if all assets load successfully
+        bool anResult = true;
+
+        // Loop through each slot chunk and load the assets it holds
+        const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_acquire);
+        for(Uint32 anIndex = 0; anIndex < anChunkCount; anIndex++)
+        {
+          // The asset ID's found in this chunk that still need to be loaded
+          std::vector<AssetKey> anUnloaded;
+          GetUnloaded(anIndex, anUnloaded);
+
+          // Load each unloaded asset, waiting for loads already in flight
+          for(size_t anAsset = 0; anAsset < anUnloaded.size(); anAsset++)
+          {
+            // Set our return result
+            anResult &= LoadAsset(anUnloaded[anAsset]);
+          }
+        }
+
+        // Return anResult which will still be true if all LoadAllAssets returned
+        // true or there are no registered Assets, false otherwise
+        return anResult;
+      }
+
+      /**
+       * LoadAllAssetsAsync is responsible for starting the load of every
+       * unloaded asset currently registered with this IAssetHandler derived
+       * class on the AssetManager loader threads (see LoadAssetAsync).
+       * @param[out] theFutures to add the future of each load started to
+       */
+      virtual void LoadAllAssetsAsync(std::vector<std::shared_future<bool> >& theFutures)
+      {
+        // Loop through each slot chunk and start loading the assets it holds
+        const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_acquire);
+        for(Uint32 anIndex = 0; anIndex < anChunkCount; anIndex++)
+        {
+          // The asset ID's found in this chunk that still need to be loaded
+          std::vector<AssetKey> anUnloaded;
+          GetUnloaded(anIndex, anUnloaded);
+
+          // Start each load, loads already in flight return their future
+          for(size_t anAsset = 0; anAsset < anUnloaded.size(); anAsset++)
+          {
+            theFutures.push_back(LoadAssetAsync(anUnloaded[anAsset]));
+          }
+        }
+      }
+
+      /**
+       * LoadPendingAssets is responsible for loading unloaded AssetLoadLater
+       * assets on the calling thread until theDeadline has passed. Each call
+       * continues with the slot chunk where the previous call ran out of
+       * time. A load that has started is never interrupted so theDeadline
+       * may be overrun by up to one load.
+       * @param[in] theDeadline after which no more loads are started
+       * @return the number of AssetLoadLater assets still waiting to be
+       *   loaded, assets whose last load failed aren't counted
+       */
+      virtual Uint32 LoadPendingAssets(std::chrono::steady_clock::time_point theDeadline)
+      {
+        // Slot chunk to continue from next time, the first one we run out
+        // of time in
+        const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_acquire);
+        const Uint32 anFirst = (0 < anChunkCount) ? mPendingChunk % anChunkCount : 0;
+        Uint32 anResume = anFirst;
+        bool anExpired = false;
+
+        // The asset ID's found in each chunk that haven't been loaded
+        std::vector<AssetKey> anPending;
+
+        // Loop through each slot chunk once starting where the last call
+        // stopped, the rest is left for the next call once time runs out
+        for(Uint32 anCount = 0; anCount < anChunkCount && false == anExpired; anCount++)
+        {
+          const Uint32 anIndex = (anFirst + anCount) % anChunkCount;
+          if(std::chrono::steady_clock::now() >= theDeadline)
+          {
+            anExpired = true;
+            anResume = anIndex;
+            break;
+          }
+          anPending.clear();
+          GetUnloaded(anIndex, anPending);
+
+          // Load each one while there is time left
+          for(size_t anAsset = 0; anAsset < anPending.size(); anAsset++)
+          {
+            // Skip assets that aren't waiting for LoadPendingAssets
+            if(false == IsLoadPending(anPending[anAsset]))
+            {
+              continue;
+            }
+            if(std::chrono::steady_clock::now() >= theDeadline)
+            {
+              anExpired = true;
+              anResume = anIndex;
+              break;
+            }
+            LoadAsset(anPending[anAsset]);
+          }
+        }
+
+        // Remember where to continue next time
+        mPendingChunk = anResume;
+
+        // Return the number of assets that are still waiting without
+        // scanning the rest of the slot map
+        return (Uint32)mPendingAssets.load();
+      }
+
+      /**
+       * FinalizeLoads is responsible for finishing every asset loaded on the
+       * loader threads that must be finished on the thread that uses the
+       * assets (see NeedsFinalize). Call this regularly from that thread
+       * (see AssetManager::Update), the loads aren't done until it is called.
+       */
+      virtual void FinalizeLoads(void)
+      {
+        // Take every load waiting to be finalized
+        std::vector<typeAssetData*> anFinalizes;
+        {
+          std::lock_guard<std::mutex> anLock(mFinalizeMutex);
+          anFinalizes.swap(mFinalizes);
+        }
+
+        // Finalize and publish each one, our claim keeps each asset alive
+        for(size_t anIndex = 0; anIndex < anFinalizes.size(); anIndex++)
+        {
+          typeAssetData* anAssetData = anFinalizes[anIndex];
+          FinishLoad(anAssetData, Finalize(anAssetData->key, *anAssetData->asset));
+        }
+      }
+
+      /**
+       * GetLoadNanoseconds returns the total time this handler has spent
+       * loading and finalizing assets, summed across every thread.
+       * @return the total load time in nanoseconds
+       */
+      virtual Uint64 GetLoadNanoseconds(void) const
+      {
+        return mLoadNanoseconds;
+      }
+
+      /**
+       * GetCoalescedLoads returns the number of times LoadAsset or
+       * LoadAssetAsync joined a load already in flight instead of loading
+       * the same asset a second time.
+       * @return the number of loads coalesced
+       */
+      virtual Uint64 GetCoalescedLoads(void) const
+      {
+        return mCoalescedLoads;
+      }
+
+      /**
+       * GetStats is responsible for filling theStats with the counters of
+       * this handler. The registered and loaded assets are counted from the
+       * hot arrays of the slot map. The load times are those of LoadByStyle,
+       * finalizing is only counted in loadNanoseconds.
+       * @param[out] theStats to fill
+       */
+      virtual void GetStats(typeAssetStats& theStats) const
+      {
+        theStats.assets = 0;
+        theStats.loadedAssets = 0;
+
+        // Count the registered and loaded assets of each slot chunk, the hot
+        // fields are atomic so no lock is needed for these statistics
+        {
+          const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_acquire);
+          for(Uint32 anChunk = 0; anChunk < anChunkCount; anChunk++)
+          {
+            const typeSlotChunk& anSlots = GetSlotChunk(anChunk * POOL_CHUNK_SIZE);
+            for(Uint32 anIndex = 0; anIndex < POOL_CHUNK_SIZE; anIndex++)
+            {
+              if(0 != (anSlots.generations[anIndex].load(std::memory_order_relaxed) & 1))
+              {
+                theStats.assets++;
+                if(anSlots.loaded[anIndex].load(std::memory_order_relaxed))
+                {
+                  theStats.loadedAssets++;
+                }
+              }
+            }
+          }
+          theStats.assetsMaximum = (Uint32)mAssetsMaximum.load();
+        }
+
+        theStats.deferredAssets = mDeferredCount;
+        theStats.residentBytes = mResidentBytes;
+        theStats.residentBytesMaximum = mResidentBytesMaximum;
+        theStats.memoryBudget = mMemoryBudget;
+        theStats.referenceHits = mReferenceHits;
+        theStats.referenceCreates = mReferenceCreates;
+        theStats.loads = mLoads;
+        theStats.loadFailures = mLoadFailures;
+        theStats.coalescedLoads = mCoalescedLoads;
+        theStats.sharedLoads = mSharedLoads;
+        theStats.loadNanoseconds = mLoadNanoseconds;
+        theStats.loadNanosecondsMaximum = mLoadNanosecondsMaximum;
+        for(Uint32 anIndex = 0; anIndex < LOAD_TIME_BUCKETS; anIndex++)
+        {
+          theStats.loadTimes[anIndex] = mLoadTimes[anIndex];
+        }
+      }
+
+      /**
+       * SetMemoryBudget sets the number of bytes this handler may keep
+       * resident before unused AssetDropLRU assets are released, oldest
+       * first. A budget of 0 (default) means there is no limit.
+       * @param[in] theBytes this handler may keep resident or 0 for no limit
+       */
+      virtual void SetMemoryBudget(Uint64 theBytes)
+      {
+        mMemoryBudget = theBytes;
+
+        // Trim right away in case we are already over the new budget
+        CheckMemoryBudget();
+      }
+
+      /**
+       * GetMemoryBudget returns the memory budget set by SetMemoryBudget.
+       * @return the memory budget in bytes or 0 if there is no limit
+       */
+      virtual Uint64 GetMemoryBudget(void) const
+      {
+        return mMemoryBudget;
+      }
+
+      /**
+       * GetResidentBytes returns the number of bytes used by every loaded
+       * asset this handler manages as reported by GetAssetSize.
+       * @return the number of bytes currently resident
+       */
+      virtual Uint64 GetResidentBytes(void) const
+      {
+        return mResidentBytes;
+      }
+
+      /**
+       * TrimCache is responsible for releasing unused AssetDropLRU assets,
+       * least recently used first, until at least theBytes have been freed
+       * or no unused assets remain.
+       * @param[in] theBytes to try to free
+       * @return the number of bytes actually freed
+       */
+      virtual Uint64 TrimCache(Uint64 theBytes)
+      {
+        // Number of bytes freed so far
+        Uint64 anResult = 0;
+
+        while(anResult < theBytes)
+        {
+          // The least recently used asset to try and release
+          AssetKey anAssetID;
+          {
+            std::lock_guard<std::mutex> anLock(mCacheMutex);
+            if(NULL == mCacheTail)
+            {
+              break;
+            }
+            anAssetID = mCacheTail->key;
+          }
+
+          // Asset Data to delete once the shard lock has been given up
+          typeAssetData* anReleased = NULL;
+
+          // The shard lock must be taken before the cache lock
+          {
+            typeAssetShard& anShard = GetShard(anAssetID);
+            std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+            // Make sure nobody started using the asset again in the meantime
+            typeAssetData* anAssetData = FindAsset(anShard, anAssetID);
+            if(NULL != anAssetData && anAssetData->cached && 0 == anAssetData->count)
+            {
+              Uncache(*anAssetData);
+              anShard.assets.remove(anAssetID.GetHash());
+              anReleased = anAssetData;
+            }
+          }
+
+          // Release the asset outside of the shard lock
+          if(NULL != anReleased)
+          {
+            anResult += anReleased->size;
+            DeleteAssetData(anReleased);
+          }
+        }
+
+        // Return the number of bytes freed
+        return anResult;
+      }
+
+      /**
+       * ReleaseDeferredAssets is responsible for releasing unused
+       * AssetDropDeferred assets, oldest first, until theDeadline has passed.
+       * Assets used again before their turn came were revived without being
+       * unloaded and are skipped. Call this where ReleaseAsset is safe to
+       * run, typically through AssetManager::Update, or from a thread of
+       * your own if ReleaseAsset may run on any thread. A release that has
+       * started is never interrupted.
+       * @param[in] theDeadline after which no more assets are released
+       * @return the number of AssetDropDeferred assets still waiting
+       */
+      virtual Uint32 ReleaseDeferredAssets(std::chrono::steady_clock::time_point theDeadline)
+      {
+        while(std::chrono::steady_clock::now() < theDeadline)
+        {
+          // The asset that has been waiting the longest
+          AssetKey anAssetID;
+          {
+            std::lock_guard<std::mutex> anLock(mDeferredMutex);
+            if(mDeferred.empty())
+            {
+              break;
+            }
+            anAssetID = mDeferred.front();
+            mDeferred.pop_front();
+          }
+
+          // Asset Data to delete once the shard lock has been given up
+          typeAssetData* anReleased = NULL;
+
+          // The shard lock must be taken before the release queue lock
+          {
+            typeAssetShard& anShard = GetShard(anAssetID);
+            std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+            // Make sure nobody started using the asset again in the meantime
+            typeAssetData* anAssetData = FindAsset(anShard, anAssetID);
+            if(NULL != anAssetData && anAssetData->deferred && 0 == anAssetData->count)
+            {
+              anAssetData->deferred = false;
+              mDeferredCount--;
+              anShard.assets.remove(anAssetID.GetHash());
+              anReleased = anAssetData;
+            }
+          }
+
+          // Release the asset outside of the shard lock
+          DeleteAssetData(anReleased);
+        }
+
+        // Return the number of assets that are still waiting
+        return mDeferredCount;
+      }
+
+      /**
+       * ReloadFile is responsible for reloading every loaded
+       * AssetLoadFromFile asset whose filename (see GetFilename) matches
+       * theFilename provided. Each asset is loaded into a fresh TYPE on the
+       * loader threads and swapped in by FinishReloads, so the TYPE address
+       * held by each TAsset never changes. Unused AssetDropLRU assets are
+       * simply released so they are loaded again the next time they are used
+       * and assets that failed to load may be loaded again right away.
+       * Assets sharing the TYPE of another asset (see SetContentSharing)
+       * only change when that asset is reloaded, which is skipped while any
+       * asset sharing it is loaded from a file other than theFilename.
+       * @param[in] theFilename that changed on disk
+       * @return the number of assets being reloaded or released
+       */
+      virtual Uint32 ReloadFile(const std::string& theFilename)
+      {
+        // Assets to reload, unused assets to release and failed assets to retry
+        std::vector<typeAssetData*> anReloads;
+        std::vector<typeAssetData*> anReleased;
+        std::vector<AssetKey> anShared;
+        Uint32 anRetries = 0;
+
+        // Count the assets sharing a TYPE that are loaded from theFilename
+        // too, only they may see the TYPE change (see SetContentSharing)
+        std::map<typeAssetData*, Uint32> anSameFile;
+        for(size_t anIndex = 0; anIndex < SHARD_COUNT; anIndex++)
+        {
+          typeAssetShard& anShard = mShards[anIndex];
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          for(Uint32 anSlot = 0; anSlot < anShard.assets.capacity(); anSlot++)
+          {
+            if(anShard.assets.isUsed(anSlot))
+            {
+              typeAssetData* anAssetData = anShard.assets.itemAt(anSlot);
+              if(NULL != anAssetData->content &&
+                theFilename == (anAssetData->filename.empty() ?
+                  anAssetData->key.GetID() : anAssetData->filename))
+              {
+                anSameFile[anAssetData->content]++;
+              }
+            }
+          }
+        }
+
+        // Loop through each shard looking for assets loaded from theFilename
+        for(size_t anIndex = 0; anIndex < SHARD_COUNT; anIndex++)
+        {
+          typeAssetShard& anShard = mShards[anIndex];
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          for(Uint32 anSlot = 0; anSlot < anShard.assets.capacity(); anSlot++)
+          {
+            // Skip slots that don't hold a loaded asset from theFilename
+            if(false == anShard.assets.isUsed(anSlot))
+            {
+              continue;
+            }
+            typeAssetData* anAssetData = anShard.assets.itemAt(anSlot);
+            if(NULL != anAssetData->request || anAssetData->reloading ||
+              NULL != anAssetData->content ||
+              AssetLoadFromFile != anAssetData->loadStyle ||
+              theFilename != (anAssetData->filename.empty() ?
+                anAssetData->key.GetID() : anAssetData->filename))
+            {
+              continue;
+            }
+
+            // The file of an asset that failed to load may have been fixed
+            if(false == anAssetData->loaded)
+            {
+              if(0 != anAssetData->retryTime)
+              {
+                anAssetData->retryTime = 0;
+                UpdatePending(*anAssetData);
+                anRetries++;
+              }
+              continue;
+            }
+
+            // Nobody may share the old bytes once the file changed
+            if(0 != anAssetData->contentHash)
+            {
+              RemoveContent(*anAssetData);
+            }
+
+            // Don't change a TYPE shared by assets loaded from other files
+            if(anAssetData->sharers != anSameFile[anAssetData])
+            {
+              anShared.push_back(anAssetData->key);
+              continue;
+            }
+
+            if(anAssetData->cached || anAssetData->deferred)
+            {
+              // Nobody is using it, release it now and load it again on demand
+              Revive(*anAssetData);
+              anShard.assets.remove(anAssetData->key.GetHash());
+              anReleased.push_back(anAssetData);
+              anSlot--;
+            }
+            else
+            {
+              // Hold a reference so the asset can't be released mid reload
+              anAssetData->reloading = true;
+              anAssetData->count++;
+              anReloads.push_back(anAssetData);
+            }
+          }
+        }
+
+        // Log the assets that keep their contents for the assets sharing them
+        for(size_t anIndex = 0; anIndex < anShared.size(); anIndex++)
+        {
+          WLOG() << "TAssetHandler(" << GetID() << "):ReloadFile("
+            << theFilename << ") Not reloading " << anShared[anIndex]
+            << ", assets loaded from other files share its contents" << std::endl;
+        }
+
+        // Release the unused assets outside of the shard locks
+        for(size_t anIndex = 0; anIndex < anReleased.size(); anIndex++)
+        {
+          ILOG() << "TAssetHandler(" << GetID() << "):ReloadFile("
+            << theFilename << ") Releasing unused asset "
+            << anReleased[anIndex]->key << std::endl;
+          DeleteAssetData(anReleased[anIndex]);
+        }
+
+        // Reload the others on the loader threads or right here if we have none
+        for(size_t anIndex = 0; anIndex < anReloads.size(); anIndex++)
+        {
+          AssetLoader::typeLoadTask anTask =
+            std::bind(&TAssetHandler<TYPE>::RunReload, this, anReloads[anIndex]);
+          if(false == AddLoadTask(anTask))
+          {
+            anTask();
+          }
+        }
+
+        // Return the number of assets affected
+        return (Uint32)(anReloads.size() + anReleased.size()) + anRetries;
+      }
+
+      /**
+       * FinishReloads is responsible for swapping every asset reloaded by
+       * ReloadFile into place. Call this from the thread that uses the
+       * assets (see AssetManager::Update) since the contents of each TYPE
+       * change. Assets that failed to reload keep their previous contents.
+       */
+      virtual void FinishReloads(void)
+      {
+        // Take every completed reload
+        std::vector<typeReload> anReloads;
+        {
+          std::lock_guard<std::mutex> anLock(mReloadMutex);
+          anReloads.swap(mReloads);
+        }
+
+        for(size_t anIndex = 0; anIndex < anReloads.size(); anIndex++)
+        {
+          typeAssetData* anAssetData = anReloads[anIndex].assetData;
+          TYPE* anFresh = anReloads[anIndex].asset;
+
+          // Finish the fresh asset on this thread before it is swapped in
+          if(anReloads[anIndex].loaded && NeedsFinalize())
+          {
+            anReloads[anIndex].loaded = Finalize(anAssetData->key, *anFresh);
+          }
+
+          if(anReloads[anIndex].loaded)
+          {
+            // Swap the contents so the TYPE address held by each TAsset stays valid
+            const Uint64 anSize = GetAssetSize(*anFresh);
+            SwapAsset(*anAssetData->asset, *anFresh);
+
+            // Count the new size against the memory budget
+            Uint64 anOldSize = 0;
+            {
+              typeAssetShard& anShard = GetShard(anAssetData->key);
+              std::lock_guard<std::mutex> anLock(anShard.mutex);
+              anOldSize = anAssetData->size;
+              anAssetData->size = anSize;
+              anAssetData->reloading = false;
+            }
+            mResidentBytes -= anOldSize;
+            RaiseMaximum(mResidentBytesMaximum, mResidentBytes += anSize);
+
+            ILOG() << "TAssetHandler(" << GetID() << "):FinishReloads("
+              << anAssetData->key << ") Asset reloaded" << std::endl;
+          }
+          else
+          {
+            {
+              typeAssetShard& anShard = GetShard(anAssetData->key);
+              std::lock_guard<std::mutex> anLock(anShard.mutex);
+              anAssetData->reloading = false;
+            }
+
+            ELOG() << "TAssetHandler(" << GetID() << "):FinishReloads("
+              << anAssetData->key << ") Reload failed, keeping previous asset!"
+              << std::endl;
+          }
+
+          // Release the fresh asset which now holds the previous contents
+          if(NULL != anFresh)
+          {
+            ReleaseAsset(anAssetData->key.GetID(), anFresh);
+          }
+
+          // Give back the reference taken by ReloadFile
+          DropReference(anAssetData);
+        }
+
+        // The reloaded assets might be larger than before
+        if(false == anReloads.empty())
+        {
+          CheckMemoryBudget();
+        }
+      }
+
+      /**
+       * SetRetryDelay sets how long to wait before loading an asset again
+       * after a load fails. The delay starts at theInitialDelay and doubles
+       * after each failure in a row up to theMaximumDelay. An initial delay
+       * of 0 means failed assets are only loaded again by RetryAsset.
+       * @param[in] theInitialDelay in milliseconds after the first failure
+       * @param[in] theMaximumDelay in milliseconds after many failures
+       */
+      virtual void SetRetryDelay(Uint32 theInitialDelay, Uint32 theMaximumDelay)
+      {
+        mRetryDelay = theInitialDelay;
+        mRetryDelayMaximum = (theMaximumDelay < theInitialDelay) ?
+          theInitialDelay : theMaximumDelay;
+      }
+
+      /**
+       * SetContentSharing enables or disables content sharing for assets
+       * loaded from now on. While enabled the bytes of each asset are hashed
+       * (see GetContentHash) before it is loaded and an asset whose hash,
+       * size and bytes (see CompareContent) match an asset loaded before
+       * shares its TYPE and holds a reference to it instead of loading and
+       * keeping its own copy. Assets already loaded are not affected.
+       * @param[in] theEnabled true to share identical content, false otherwise
+       */
+      virtual void SetContentSharing(bool theEnabled)
+      {
+        mContentSharing = theEnabled;
+
+        // Forget the file hashes cached while sharing was enabled
+        if(false == theEnabled)
+        {
+          std::lock_guard<std::mutex> anLock(mContentMutex);
+          mFileHashes.clear();
+        }
+      }
+
+      /**
+       * IsContentSharing returns the value set by SetContentSharing.
+       * @return true if identical content is shared, false otherwise
+       */
+      virtual bool IsContentSharing(void) const
+      {
+        return mContentSharing;
+      }
+
+      /**
+       * GetLoadFailure is responsible for retrieving why the last load of
+       * theAssetID failed and when it may be loaded again.
+       * @param[in] theAssetID of the asset to check
+       * @param[out] theFailure information about the failed loads
+       * @return true if the last load of theAssetID failed, false otherwise
+       */
+      virtual bool GetLoadFailure(const AssetKey& theAssetID,
+        typeLoadFailure& theFailure) const
+      {
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        // Only assets whose last load failed have failure information
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+        if(NULL == anAssetData || NULL == anAssetData->failure ||
+          0 == anAssetData->failure->failures)
+        {
+          return false;
+        }
+        theFailure = *anAssetData->failure;
+        return true;
+      }
+
+      /**
+       * RetryAsset is responsible for loading theAssetID again right away
+       * even if its retry delay has not passed yet.
+       * @param[in] theAssetID of the asset to load again
+       * @return true if theAssetID was loaded, false otherwise
+       */
+      virtual bool RetryAsset(const AssetKey& theAssetID)
+      {
+        // Allow the asset to be loaded again
+        {
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+          if(NULL != anAssetData)
+          {
+            anAssetData->retryTime = 0;
+            UpdatePending(*anAssetData);
+          }
+        }
+
+        // Return the result of loading it now
+        return LoadAsset(theAssetID);
+      }
+
+      /**
+       * AddDependency is responsible for recording that theAssetID depends on
+       * theDependencyID of theHandler (see IAssetHandler::AddDependency).
+       * @param[in] theAssetID of the asset that depends on the other
+       * @param[in] theHandler holding the dependency
+       * @param[in] theDependencyID of the asset depended on
+       * @return true if the dependency is recorded, false otherwise
+       */
+      virtual bool AddDependency(const AssetKey& theAssetID,
+        IAssetHandler& theHandler, const AssetKey& theDependencyID)
+      {
+        // Refuse dependencies that would keep each other alive forever
+        if((&theHandler == this && theAssetID == theDependencyID) ||
+          theHandler.IsDependency(theDependencyID, *this, theAssetID))
+        {
+          ELOG() << "TAssetHandler(" << GetID() << "):AddDependency("
+            << theAssetID << ", " << theDependencyID
+            << ") Dependency would make a cycle!" << std::endl;
+          return false;
+        }
+
+        // Hold our reference to the dependency before it is recorded
+        if(false == theHandler.AddReference(theDependencyID))
+        {
+          return false;
+        }
+
+        // Was theAssetID found and was the dependency new to it?
+        bool anFound = false;
+        bool anAdded = false;
+        {
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+          if(NULL != anAssetData)
+          {
+            anFound = true;
+            anAdded = true;
+            for(size_t anIndex = 0; anIndex < anAssetData->dependencies.size(); anIndex++)
+            {
+              if(&theHandler == anAssetData->dependencies[anIndex].handler &&
+                theDependencyID == anAssetData->dependencies[anIndex].key)
+              {
+                anAdded = false;
+                break;
+              }
+            }
+            if(anAdded)
+            {
+              typeAssetDependency anDependency;
+              anDependency.handler = &theHandler;
+              anDependency.key = theDependencyID;
+              anAssetData->dependencies.push_back(anDependency);
+            }
+          }
+        }
+
+        // Only keep the reference if the dependency was recorded
+        if(false == anAdded)
+        {
+          theHandler.DropReference(theDependencyID);
+        }
+        if(false == anFound)
+        {
+          WLOG() << "TAssetHandler(" << GetID() << "):AddDependency("
+            << theAssetID << ") Asset ID provided not found!" << std::endl;
+        }
+
+        // Return true if theAssetID depends on theDependencyID now
+        return anFound;
+      }
+
+      /**
+       * AddDependency is responsible for recording that theAssetID depends on
+       * theDependencyID of the handler registered for the DEPENDENCY asset
+       * type with our AssetManager, typically called by LoadFromFile once
+       * the dependencies of the asset are known, e.g. a font calling
+       * AddDependency<Texture>(theAssetID, "atlas.png").
+       * @param[in] theAssetID of the asset that depends on the other
+       * @param[in] theDependencyID of the DEPENDENCY asset depended on
+       * @return true if the dependency is recorded, false otherwise
+       */
+      template <class DEPENDENCY>
+      bool AddDependency(const AssetKey& theAssetID, const AssetKey& theDependencyID)
+      {
+        IAssetHandler* anHandler = FindHandler(typeid(DEPENDENCY).name());
+        if(NULL == anHandler)
+        {
+          ELOG() << "TAssetHandler(" << GetID() << "):AddDependency("
+            << theAssetID << ", " << theDependencyID << ") No handler for "
+            << typeid(DEPENDENCY).name() << " registered!" << std::endl;
+          return false;
+        }
+        return AddDependency(theAssetID, *anHandler, theDependencyID);
+      }
+
+      /**
+       * GetDependencies is responsible for adding every asset theAssetID
+       * depends on to theDependencies in the order they were added.
+       * @param[in] theAssetID of the asset to get the dependencies of
+       * @param[out] theDependencies to add each dependency to
+       */
+      virtual void GetDependencies(const AssetKey& theAssetID,
+        std::vector<typeAssetDependency>& theDependencies) const
+      {
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+        if(NULL != anAssetData)
+        {
+          theDependencies.insert(theDependencies.end(),
+            anAssetData->dependencies.begin(), anAssetData->dependencies.end());
+        }
+      }
+
+      /**
+       * ClearDependencies is responsible for dropping the references every
+       * asset of this handler holds to its dependencies.
+       */
+      virtual void ClearDependencies(void)
+      {
+        // Dependencies to drop once the shard lock has been given up
+        std::vector<typeAssetDependency> anDependencies;
+
+        for(size_t anIndex = 0; anIndex < SHARD_COUNT; anIndex++)
+        {
+          typeAssetShard& anShard = mShards[anIndex];
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          for(Uint32 anSlot = 0; anSlot < anShard.assets.capacity(); anSlot++)
+          {
+            if(anShard.assets.isUsed(anSlot))
+            {
+              std::vector<typeAssetDependency>& anAssetDependencies =
+                anShard.assets.itemAt(anSlot)->dependencies;
+              anDependencies.insert(anDependencies.end(),
+                anAssetDependencies.begin(), anAssetDependencies.end());
+              anAssetDependencies.clear();
+            }
+          }
+        }
+
+        // Dropping these may delete assets that had dependencies of their own
+        for(size_t anIndex = 0; anIndex < anDependencies.size(); anIndex++)
+        {
+          anDependencies[anIndex].handler->DropReference(anDependencies[anIndex].key);
+        }
+      }
+
+      /**
+       * GetUnloadedAssets is responsible for adding the key of every asset
+       * registered with this handler that is not loaded to theAssetIDs.
+       * @param[out] theAssetIDs to add each unloaded asset key to
+       */
+      virtual void GetUnloadedAssets(std::vector<AssetKey>& theAssetIDs)
+      {
+        const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_acquire);
+        for(Uint32 anIndex = 0; anIndex < anChunkCount; anIndex++)
+        {
+          GetUnloaded(anIndex, theAssetIDs);
+        }
+      }
 
     protected:
       /**
-       * AcquireAsset is responsible for creating an IAsset derived asset and
-       * returning it to the caller.
-       * @param[in] theAssetID of the asset to acquire
-       * @return a pointer to the newly created asset
+       * SetLoadError is responsible for noting theReason the load of
+       * theAssetID in progress is failing, derived LoadFrom methods call
+       * this before returning false (see GetLoadFailure).
+       * @param[in] theAssetID of the asset being loaded
+       * @param[in] theReason the load failed
+       */
+      void SetLoadError(const AssetKey& theAssetID, const std::string& theReason)
+      {
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+        if(NULL != anAssetData)
+        {
+          if(NULL == anAssetData->failure)
+          {
+            anAssetData->failure.reset(new typeLoadFailure());
+            anAssetData->failure->failures = 0;
+          }
+          anAssetData->failure->reason = theReason;
+        }
+      }
+
+      /**
+       * GetAssetSize is responsible for returning the number of bytes
+       * theAsset uses once it has been loaded which is counted against the
+       * memory budget. Derived classes should return the real size of the
+       * data held by theAsset (e.g. pixels of a texture).
+       * @param[in] theAsset that was just loaded
+       * @return the number of bytes used by theAsset
+       */
+      virtual Uint64 GetAssetSize(const TYPE& theAsset) const
+      {
+        return sizeof(TYPE);
+      }
+
+      /**
+       * SwapAsset is responsible for exchanging the contents of theAsset
+       * with theFresh asset that was just reloaded by ReloadFile. theFresh
+       * is released with ReleaseAsset afterwards. Derived classes can
+       * override this if TYPE can't be swapped with std::swap.
+       * @param[in] theAsset held by every TAsset for the asset ID
+       * @param[in] theFresh asset that was just reloaded
+       */
+      virtual void SwapAsset(TYPE& theAsset, TYPE& theFresh)
+      {
+        std::swap(theAsset, theFresh);
+      }
+
+      /**
+       * NeedsFinalize returns true if assets loaded on the loader threads
+       * must be finished by FinalizeAsset on the thread that calls
+       * FinalizeLoads, for example to create a texture with a renderer that
+       * may only be used on one thread. The default returns false.
+       * @return true if FinalizeAsset must be called for each loaded asset
+       */
+      virtual bool NeedsFinalize(void) const
+      {
+        return false;
+      }
+
+      /**
+       * FinalizeAsset is responsible for finishing theAsset after it was
+       * loaded, always on the thread that calls FinalizeLoads or the thread
+       * that called LoadAsset. Only called if NeedsFinalize returns true.
+       * @param[in] theAssetID of the asset to finish
+       * @param[in] theAsset that was just loaded
+       * @return true if theAsset was finished, false otherwise
+       */
+      virtual bool FinalizeAsset(const typeAssetID theAssetID, TYPE& theAsset)
+      {
+        return true;
+      }
+
+      /**
+       * GetContentHash is responsible for hashing the bytes theAssetID will
+       * be loaded from (see HashAssetData), only called while content
+       * sharing is enabled (see SetContentSharing). The default hashes the
+       * file named by GetFilename for AssetLoadFromFile assets, reusing the
+       * hash of a file whose size and modification time haven't changed
+       * since it was last hashed, and the memory source or asset pack bytes
+       * for AssetLoadFromMemory assets. Derived classes whose assets are
+       * loaded from more than these bytes must override this and
+       * CompareContent or leave content sharing disabled.
+       * @param[in] theAssetID of the asset to hash
+       * @param[in] theLoadStyle the asset will be loaded with
+       * @param[out] theHash of the bytes found
+       * @param[out] theSize of the bytes found
+       * @return true if theHash was set, false if the asset can't be shared
+       */
+      virtual bool GetContentHash(const AssetKey& theAssetID,
+        AssetLoadStyle theLoadStyle, Uint64& theHash, Uint64& theSize)
+      {
+        if(AssetLoadFromFile == theLoadStyle)
+        {
+          // Reuse the hash of the file if it hasn't changed since
+          const std::string anFilename = GetFilename(theAssetID);
+          struct stat anStat;
+          if(0 != stat(anFilename.c_str(), &anStat))
+          {
+            return false;
+          }
+          const Uint64 anKey = HashAssetData(anFilename.data(), anFilename.size());
+          {
+            std::lock_guard<std::mutex> anLock(mContentMutex);
+            const typeFileHash* anEntry = mFileHashes.find(anKey);
+            if(NULL != anEntry && anEntry->filename == anFilename &&
+              anEntry->size == (Uint64)anStat.st_size &&
+              anEntry->modified == (Uint64)anStat.st_mtime)
+            {
+              theHash = anEntry->hash;
+              theSize = anEntry->size;
+              return true;
+            }
+          }
+
+          // Read and hash the whole file, LoadFromFile will find it in the
+          // OS cache, a file changed since the stat above is only cached
+          // under its old size and time and is hashed again next time
+          typeMemorySource anContent;
+          if(false == ReadContent(theAssetID, theLoadStyle, anContent))
+          {
+            return false;
+          }
+          theHash = HashAssetData(anContent.data.data, anContent.data.size);
+          theSize = anContent.data.size;
+          typeFileHash anFileHash;
+          anFileHash.filename = anFilename;
+          anFileHash.size = (Uint64)anStat.st_size;
+          anFileHash.modified = (Uint64)anStat.st_mtime;
+          anFileHash.hash = theHash;
+          {
+            std::lock_guard<std::mutex> anLock(mContentMutex);
+            mFileHashes.insert(anKey, anFileHash);
+          }
+          return true;
+        }
+        else if(AssetLoadFromMemory == theLoadStyle)
+        {
+          // Hash the bytes in place, the copy keeps any shared buffer alive
+          typeMemorySource anSource;
+          if(false == ReadContent(theAssetID, theLoadStyle, anSource))
+          {
+            return false;
+          }
+          theHash = HashAssetData(anSource.data.data, anSource.data.size);
+          theSize = anSource.data.size;
+          return true;
+        }
+
+        // Network assets can't be hashed before they are loaded
+        return false;
+      }
+
+      /**
+       * CompareContent is responsible for confirming that the bytes
+       * theAssetID will be loaded from are identical to the bytes
+       * theContentID was loaded from, called before sharing whenever their
+       * hash and size match (see GetContentHash). The default compares the
+       * bytes hashed by the default GetContentHash.
+       * @param[in] theAssetID of the asset that would share the TYPE
+       * @param[in] theLoadStyle theAssetID will be loaded with
+       * @param[in] theContentID of the asset whose TYPE would be shared
+       * @param[in] theContentStyle theContentID was loaded with
+       * @return true if the bytes are identical, false otherwise
+       */
+      virtual bool CompareContent(const AssetKey& theAssetID,
+        AssetLoadStyle theLoadStyle, const AssetKey& theContentID,
+        AssetLoadStyle theContentStyle)
+      {
+        // Read both, the same pack or memory source bytes needn't be compared
+        typeMemorySource anContent;
+        typeMemorySource anOther;
+        return ReadContent(theAssetID, theLoadStyle, anContent) &&
+          ReadContent(theContentID, theContentStyle, anOther) &&
+          anContent.data.size == anOther.data.size &&
+          (anContent.data.data == anOther.data.data || 0 == anContent.data.size ||
+          0 == memcmp(anContent.data.data, anOther.data.data, (size_t)anContent.data.size));
+      }
+
+      /**
+       * AcquireAsset is responsible for creating an IAsset derived asset and
+       * returning it to the caller. It is called while the shard lock for
+       * theAssetID is held. The default constructs the asset in the pool of
+       * that shard, derived classes that override AcquireAsset must override
+       * ReleaseAsset to match.
+       * @param[in] theAssetID of the asset to acquire
+       * @return a pointer to the newly created asset
+       */
+      virtual TYPE* AcquireAsset(const typeAssetID theAssetID)
+      {
+        ILOG() << "TAssetHandler(" << GetID() << "):AcquireAsset("
+          << theAssetID << ") Creating asset" << std::endl;
+
+        // Construct the asset in the pool of its shard, our caller holds the
+        // shard lock that protects it
+        return GetShard(theAssetID).assetPool.acquire();
+      }
+
+      /**
+       * ReleaseAsset is responsible for unloading and removing theAsset
+       * specified and deleting the memory used by the asset. It is called
+       * without holding any shard lock. Derived classes that only override
+       * ReleaseAsset must call this version to give the memory back instead
+       * of deleting theAsset themselves.
+       * @param[in] theAssetID of the asset to be released
+       * @param[in] theAsset to be released
+       */
+      virtual void ReleaseAsset(const typeAssetID theAssetID, TYPE* theAsset)
+      {
+        ILOG() << "TAssetHandler(" << GetID() << "):ReleaseAsset("
+          << theAssetID << ") Releasing asset" << std::endl;
+
+        // Just give the memory used for the asset back to the pool of its shard
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+        anShard.assetPool.release(theAsset);
+      }
+
+      /**
+       * LoadFromFile is responsible for loading theAsset from a file and must
+       * be defined by the derived class since the interface for TYPE is
+       * unknown at this stage.
+       * @param[in] theAssetID of the asset to be loaded
+       * @param[in] theAsset pointer to load
+       * @return true if the asset was successfully loaded, false otherwise
+       */
+      virtual bool LoadFromFile(const typeAssetID theAssetID, TYPE& theAsset) = 0;
+
+      /**
+       * LoadFromMemory is responsible for loading theAsset from theData
+       * provided and must be defined by the derived class since the
+       * interface for TYPE is unknown at this stage. theData is the memory
+       * source set by SetMemorySource or the bytes found in a mounted asset
+       * pack and is only guaranteed to stay valid during this call, unless
+       * the caller of SetMemorySource promises otherwise.
+       * @param[in] theAssetID of the asset to be loaded
+       * @param[in] theData read only bytes to load the asset from
+       * @param[in] theAsset pointer to load
+       * @return true if the asset was successfully loaded, false otherwise
+       */
+      virtual bool LoadFromMemory(const typeAssetID theAssetID,
+        const AssetSpan& theData, TYPE& theAsset) = 0;
+
+      /**
+       * LoadFromNetwork is responsible for loading theAsset from network and
+       * must be defined by the derived class since the interface for TYPE is
+       * unknown at this stage.
+       * @param[in] theAssetID of the asset to be loaded
+       * @param[in] theAsset pointer to load
+       * @return true if the asset was successfully loaded, false otherwise
+       */
+      virtual bool LoadFromNetwork(const typeAssetID theAssetID, TYPE& theAsset) = 0;
+
+    private:
+      // Structures
+      ///////////////////////////////////////////////////////////////////////////
+      /// Structure holding the bytes registered by SetMemorySource
+      struct typeMemorySource {
+        AssetSpan data; ///< Bytes to hand to LoadFromMemory
+        /// Shared buffer that owns the bytes above or NULL if the caller does
+        std::shared_ptr<const std::vector<Uint8> > buffer;
+      };
+
+      /// Structure holding the content table entry of an asset whose TYPE
+      /// may be shared by assets loaded from the same bytes
+      struct typeContent {
+        AssetKey       assetID;   ///< Asset whose TYPE may be shared
+        Uint64         size;      ///< Number of bytes hashed
+        AssetLoadStyle loadStyle; ///< Style the asset was loaded with
+      };
+
+      /// Structure holding the cached hash of a file (see GetContentHash)
+      struct typeFileHash {
+        std::string filename; ///< File that was hashed
+        Uint64      size;     ///< Size of the file when it was hashed
+        Uint64      modified; ///< Modification time of the file when it was hashed
+        Uint64      hash;     ///< Hash of the bytes of the file
+      };
+
+      /// Structure holding an asset reloaded by RunReload for FinishReloads
+      struct typeReload {
+        typeAssetData* assetData; ///< Asset Data being reloaded
+        TYPE*          asset;     ///< Fresh asset holding the reloaded contents
+        bool           loaded;    ///< Was the fresh asset loaded successfully?
+      };
+
+      /// Structure holding one independently locked portion of the asset table
+      struct typeAssetShard {
+        typeAssetShard() :
+          assetPool(POOL_CHUNK_SIZE)
+        {
+        }
+
+        std::mutex mutex;         ///< Lock protecting the tables and pools below
+        /// Table that associates asset ID hashes with their TAssetData
+        THashTable<typeAssetData*> assets;
+        /// Table that associates asset ID hashes with their memory source
+        THashTable<typeMemorySource> sources;
+        /// Pool the default AcquireAsset constructs the assets of this shard in
+        TPool<TYPE> assetPool;
+        /// Slots of the slot chunks owned by this shard not holding Asset
+        /// Data, lowest slot last
+        std::vector<Uint32> freeSlots;
+        char       pad_[64];      ///< Padding to keep shard locks off shared cache lines
+      };
+
+      /// Structure holding the storage for one Asset Data structure
+      struct typeSlotRecord {
+        alignas(typeAssetData) char bytes[sizeof(typeAssetData)]; ///< Asset Data storage
+      };
+
+      /// Structure holding one chunk of the slot map, the hot fields of each
+      /// Asset Data are kept in parallel arrays so scans read them in order.
+      /// Every slot of a chunk belongs to the same shard.
+      struct typeSlotChunk {
+        /// Index of the shard whose Asset Data this chunk holds
+        Uint32              shard;
+        /// Generation of each slot, odd while the slot holds Asset Data
+        std::atomic<Uint32> generations[POOL_CHUNK_SIZE];
+        /// Number of people referencing the Asset in each slot
+        std::atomic<Uint32> counts[POOL_CHUNK_SIZE];
+        /// Is the Asset in each slot currently loaded?
+        std::atomic<bool>   loaded[POOL_CHUNK_SIZE];
+        /// Load type (File, Memory, Network, etc) of the Asset in each slot
+        AssetLoadStyle      loadStyles[POOL_CHUNK_SIZE];
+        /// Asset Data held by each slot
+        typeSlotRecord      records[POOL_CHUNK_SIZE];
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Asset table split into shards by the hash of each asset ID
+      mutable typeAssetShard mShards[SHARD_COUNT];
+      /// Dummy asset that will be returned if an asset can't be Acquired
+      TYPE mDummyAsset;
+      /// Lock protecting the cache list below, taken after any shard lock
+      std::mutex mCacheMutex;
+      /// Most recently used unused AssetDropLRU asset
+      typeAssetData* mCacheHead;
+      /// Least recently used unused AssetDropLRU asset, released first
+      typeAssetData* mCacheTail;
+      /// Lock protecting the release queue below, taken after any shard lock
+      std::mutex mDeferredMutex;
+      /// Asset ID of each AssetDropDeferred asset in the order it became unused
+      std::deque<AssetKey> mDeferred;
+      /// Number of AssetDropDeferred assets waiting to be released
+      std::atomic<Uint32> mDeferredCount;
+      /// Bytes used by every loaded asset as reported by GetAssetSize
+      std::atomic<Uint64> mResidentBytes;
+      /// Bytes this handler may keep resident or 0 for no limit
+      std::atomic<Uint64> mMemoryBudget;
+      /// Lock protecting the completed reloads below
+      std::mutex mReloadMutex;
+      /// Reloads completed by RunReload waiting for FinishReloads
+      std::vector<typeReload> mReloads;
+      /// Milliseconds to wait before loading an asset again after it fails
+      std::atomic<Uint32> mRetryDelay;
+      /// Longest milliseconds to wait before loading a failed asset again
+      std::atomic<Uint32> mRetryDelayMaximum;
+      /// True if assets loaded from identical bytes share one TYPE
+      std::atomic<bool> mContentSharing;
+      /// Lock protecting the content and file hash tables below, taken after
+      /// any shard lock
+      std::mutex mContentMutex;
+      /// Table that associates the hash of the bytes each asset was loaded
+      /// from with the asset whose TYPE may be shared
+      THashTable<typeContent> mContents;
+      /// Table that associates the hash of each filename with its cached hash
+      THashTable<typeFileHash> mFileHashes;
+      /// Lock protecting the loads waiting for FinalizeLoads below
+      std::mutex mFinalizeMutex;
+      /// Loads completed by the loader threads waiting for FinalizeLoads
+      std::vector<typeAssetData*> mFinalizes;
+      /// Total nanoseconds spent loading and finalizing assets
+      std::atomic<Uint64> mLoadNanoseconds;
+      /// Number of loads joined by another caller while in flight
+      std::atomic<Uint64> mCoalescedLoads;
+      /// Number of loads that shared the TYPE of another asset
+      std::atomic<Uint64> mSharedLoads;
+      /// Most bytes resident at once
+      std::atomic<Uint64> mResidentBytesMaximum;
+      /// Number of references to an asset already registered
+      std::atomic<Uint64> mReferenceHits;
+      /// Number of references that registered a new asset
+      std::atomic<Uint64> mReferenceCreates;
+      /// Number of loads and reloads run by LoadByStyle
+      std::atomic<Uint64> mLoads;
+      /// Number of loads and reloads that failed
+      std::atomic<Uint64> mLoadFailures;
+      /// Longest nanoseconds a single LoadByStyle took
+      std::atomic<Uint64> mLoadNanosecondsMaximum;
+      /// Number of loads by time taken (see typeAssetStats::loadTimes)
+      std::atomic<Uint64> mLoadTimes[LOAD_TIME_BUCKETS];
+      /// Slot chunk LoadPendingAssets continues from on its next call
+      std::atomic<Uint32> mPendingChunk;
+      /// Number of unloaded AssetLoadLater assets without a load in flight
+      /// or a failed load (see UpdatePending)
+      std::atomic<Uint64> mPendingAssets;
+      /// Lock protecting the slot chunk directory below while it grows,
+      /// taken after any other lock
+      std::mutex mSlotMutex;
+      /// Directory of the chunks of the slot map each Asset Data structure is
+      /// allocated from, chunks are never moved or deleted until the handler
+      /// is deleted
+      std::atomic<std::atomic<typeSlotChunk*>*> mSlotChunks;
+      /// Number of chunks the directory above has room for
+      Uint32 mSlotDirectorySize;
+      /// Directories replaced by a larger copy, kept until the handler is
+      /// deleted since GetSlotChunk reads the directory without a lock
+      std::vector<std::atomic<typeSlotChunk*>*> mRetiredDirectories;
+      /// Number of slot chunks allocated so far
+      std::atomic<Uint32> mSlotChunkCount;
+      /// Number of slots holding Asset Data
+      std::atomic<Uint64> mAssets;
+      /// Most slots that held Asset Data at once
+      std::atomic<Uint64> mAssetsMaximum;
+
+      /**
+       * GetShard is responsible for returning the shard that holds theAssetID
+       * provided. The upper bits of the hash pick the shard since the lower
+       * bits pick the slot within each shard table.
+       * @param[in] theAssetID to find the shard for
+       * @return the shard that theAssetID belongs to
+       */
+      typeAssetShard& GetShard(const AssetKey& theAssetID) const
+      {
+        return mShards[(theAssetID.GetHash() >> 32) % SHARD_COUNT];
+      }
+
+      /**
+       * FindAsset is responsible for returning the Asset Data for theAssetID
+       * from theShard provided. The lock for theShard must be held by the
+       * caller.
+       * @param[in] theShard that theAssetID belongs to
+       * @param[in] theAssetID to find
+       * @return the Asset Data found or NULL if theAssetID isn't registered
+       */
+      typeAssetData* FindAsset(typeAssetShard& theShard, const AssetKey& theAssetID) const
+      {
+        typeAssetData* const* anFound = theShard.assets.find(theAssetID.GetHash());
+        return (NULL != anFound) ? *anFound : NULL;
+      }
+
+      /**
+       * DropLocked is responsible for decrementing the reference counter of
+       * theAssetData and removing it from theShard if it should be released.
+       * The lock for theShard must be held by the caller.
+       * @param[in] theShard that theAssetData belongs to
+       * @param[in] theAssetData to drop the reference for
+       * @param[in] theDropTime indicates if asset is dropped when count = 0 or later
+       * @return theAssetData if it was removed and should be deleted, NULL otherwise
+       */
+      typeAssetData* DropLocked(typeAssetShard& theShard,
+        typeAssetData& theAssetData, AssetDropTime theDropTime)
+      {
+        // Asset Data to be deleted by the caller
+        typeAssetData* anResult = NULL;
+
+        // Default to dropTime previously registered
+        AssetDropTime anDropTime = theAssetData.dropTime;
+
+        // Decrement the reference count for this asset
+        Uint32 anCount = --theAssetData.count;
+
+        // Caller specified another dropTime value? use it instead
+        if(AssetDropUnspecified != theDropTime &&
+          theDropTime > AssetDropUnspecified &&
+          theDropTime <= AssetDropDeferred)
+        {
+          anDropTime = theDropTime;
+        }
+
+        // Use anDropTime specified above
+        switch(anDropTime)
+        {
+        default:
+          ELOG() << "TAssetHandler(" << GetID() << ")::DropReference("
+            << theAssetData.key << ") Unknown drop time specified!" << std::endl;
+        case AssetDropUnspecified:
+        case AssetDropAtZero:
+          // See if the asset should be released and deleted
+          if(anCount == 0)
+          {
+            anResult = &theAssetData;
+
+            // Remove this Asset Data structure from our table
+            theShard.assets.remove(theAssetData.key.GetHash());
+          }
+          break;
+        case AssetDropAtExit:
+          /* Do nothing, destructor will release each asset */
+          break;
+        case AssetDropLRU:
+          // Keep a loaded asset in the cache until we go over budget
+          if(anCount == 0 && theAssetData.loaded)
+          {
+            Cache(theAssetData);
+          }
+          // Nothing worth keeping, release it right away
+          else if(anCount == 0)
+          {
+            anResult = &theAssetData;
+
+            // Remove this Asset Data structure from our table
+            theShard.assets.remove(theAssetData.key.GetHash());
+          }
+          break;
+        case AssetDropDeferred:
+          // Leave unloading a loaded asset to ReleaseDeferredAssets
+          if(anCount == 0 && theAssetData.loaded)
+          {
+            Defer(theAssetData);
+          }
+          // Nothing to unload, release it right away
+          else if(anCount == 0)
+          {
+            anResult = &theAssetData;
+
+            // Remove this Asset Data structure from our table
+            theShard.assets.remove(theAssetData.key.GetHash());
+          }
+          break;
+        }
+
+        // Return the Asset Data to delete or NULL if it is still in use
+        return anResult;
+      }
+
+      /**
+       * Cache is responsible for adding theAssetData to the front of the
+       * cache of unused assets. The shard lock for theAssetData must be held
+       * by the caller.
+       * @param[in] theAssetData that just became unused
+       */
+      void Cache(typeAssetData& theAssetData)
+      {
+        std::lock_guard<std::mutex> anLock(mCacheMutex);
+        theAssetData.cachePrev = NULL;
+        theAssetData.cacheNext = mCacheHead;
+        if(NULL != mCacheHead)
+        {
+          mCacheHead->cachePrev = &theAssetData;
+        }
+        else
+        {
+          mCacheTail = &theAssetData;
+        }
+        mCacheHead = &theAssetData;
+        theAssetData.cached = true;
+      }
+
+      /**
+       * Uncache is responsible for removing theAssetData from the cache of
+       * unused assets. The shard lock for theAssetData must be held by the
+       * caller.
+       * @param[in] theAssetData to remove from the cache
+       */
+      void Uncache(typeAssetData& theAssetData)
+      {
+        std::lock_guard<std::mutex> anLock(mCacheMutex);
+        if(NULL != theAssetData.cachePrev)
+        {
+          theAssetData.cachePrev->cacheNext = theAssetData.cacheNext;
+        }
+        else
+        {
+          mCacheHead = theAssetData.cacheNext;
+        }
+        if(NULL != theAssetData.cacheNext)
+        {
+          theAssetData.cacheNext->cachePrev = theAssetData.cachePrev;
+        }
+        else
+        {
+          mCacheTail = theAssetData.cachePrev;
+        }
+        theAssetData.cachePrev = NULL;
+        theAssetData.cacheNext = NULL;
+        theAssetData.cached = false;
+      }
+
+      /**
+       * Defer is responsible for adding theAssetData to the back of the
+       * queue of unused assets waiting for ReleaseDeferredAssets. The shard
+       * lock for theAssetData must be held by the caller.
+       * @param[in] theAssetData that just became unused
+       */
+      void Defer(typeAssetData& theAssetData)
+      {
+        std::lock_guard<std::mutex> anLock(mDeferredMutex);
+        mDeferred.push_back(theAssetData.key);
+        theAssetData.deferred = true;
+        mDeferredCount++;
+      }
+
+      /**
+       * Revive is responsible for taking theAssetData that was unused back
+       * out of the cache or the release queue. The queue entry is left
+       * behind and skipped by ReleaseDeferredAssets. The shard lock for
+       * theAssetData must be held by the caller.
+       * @param[in] theAssetData that is being used again
+       */
+      void Revive(typeAssetData& theAssetData)
+      {
+        if(theAssetData.cached)
+        {
+          Uncache(theAssetData);
+        }
+        if(theAssetData.deferred)
+        {
+          theAssetData.deferred = false;
+          mDeferredCount--;
+        }
+      }
+
+      /**
+       * CheckMemoryBudget is responsible for releasing unused assets if this
+       * handler is over its memory budget and then letting the AssetManager
+       * check the global memory budget.
+       */
+      void CheckMemoryBudget(void)
+      {
+        const Uint64 anBudget = mMemoryBudget;
+        const Uint64 anResident = mResidentBytes;
+        if(0 != anBudget && anResident > anBudget)
+        {
+          TrimCache(anResident - anBudget);
+        }
+        CheckGlobalMemoryBudget();
+      }
+
+      /**
+       * GetUnloaded is responsible for adding the asset ID of each asset in
+       * theChunk of the slot map that isn't loaded to theAssetIDs. Only the
+       * hot fields of the chunk are read.
+       * @param[in] theChunk index of the slot chunk to scan
+       * @param[out] theAssetIDs to add each unloaded asset ID to
+       */
+      void GetUnloaded(Uint32 theChunk, std::vector<AssetKey>& theAssetIDs)
+      {
+        // Slots can't be emptied or filled while we hold their shard lock
+        typeSlotChunk& anChunk = GetSlotChunk(theChunk * POOL_CHUNK_SIZE);
+        std::lock_guard<std::mutex> anLock(mShards[anChunk.shard].mutex);
+
+        for(Uint32 anIndex = 0; anIndex < POOL_CHUNK_SIZE; anIndex++)
+        {
+          if(0 != (anChunk.generations[anIndex].load(std::memory_order_relaxed) & 1) &&
+            false == anChunk.loaded[anIndex].load(std::memory_order_relaxed))
+          {
+            theAssetIDs.push_back(
+              reinterpret_cast<typeAssetData*>(anChunk.records[anIndex].bytes)->key);
+          }
+        }
+      }
+
+      /**
+       * UpdatePending is responsible for counting theAssetData in
+       * mPendingAssets while it is an unloaded AssetLoadLater asset without
+       * a load in flight or a failed load. Call it under the shard lock for
+       * theAssetData after changing any of these.
+       * @param[in] theAssetData to count
+       */
+      void UpdatePending(typeAssetData& theAssetData)
+      {
+        const bool anPending = false == theAssetData.loaded &&
+          AssetLoadLater == theAssetData.loadTime && NULL == theAssetData.request &&
+          0 == theAssetData.retryTime;
+        if(anPending != theAssetData.pending)
+        {
+          theAssetData.pending = anPending;
+          if(anPending)
+          {
+            mPendingAssets++;
+          }
+          else
+          {
+            mPendingAssets--;
+          }
+        }
+      }
+
+      /**
+       * IsLoadPending will return true if theAssetID is an unloaded
+       * AssetLoadLater asset that isn't being loaded and isn't waiting to be
+       * retried, the assets loaded by LoadPendingAssets.
+       * @param[in] theAssetID to check
+       * @return true if theAssetID is waiting for LoadPendingAssets
+       */
+      bool IsLoadPending(const AssetKey& theAssetID)
+      {
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+        typeAssetData* anAssetData = FindAsset(anShard, theAssetID);
+        return NULL != anAssetData && false == anAssetData->loaded &&
+          NULL == anAssetData->request && AssetLoadLater == anAssetData->loadTime &&
+          false == IsRetryPending(anAssetData);
+      }
+
+      /**
+       * GetSlotChunk is responsible for returning the slot chunk holding
+       * theSlot provided. theSlot must belong to a chunk already allocated.
+       * @param[in] theSlot to find the chunk for
+       * @return the slot chunk holding theSlot
+       */
+      typeSlotChunk& GetSlotChunk(Uint32 theSlot) const
+      {
+        return *mSlotChunks.load(std::memory_order_acquire)[
+          theSlot / POOL_CHUNK_SIZE].load(std::memory_order_acquire);
+      }
+
+      /**
+       * GrowSlots is responsible for allocating another slot chunk for
+       * theShard and adding its slots to the free slots of theShard. The
+       * lock of theShard must be held by the caller.
+       * @param[in] theShard to allocate the slot chunk for
+       * @return true if the chunk was allocated, false otherwise
+       */
+      bool GrowSlots(typeAssetShard& theShard)
+      {
+        std::lock_guard<std::mutex> anLock(mSlotMutex);
+        const Uint32 anChunkCount = mSlotChunkCount.load(std::memory_order_relaxed);
+        if(0xFFFFFFFFU / POOL_CHUNK_SIZE <= anChunkCount)
+        {
+          ELOG() << "TAssetHandler(" << GetID() << "):GrowSlots() slot numbers "
+            << "exhausted!" << std::endl;
+          return false;
+        }
+
+        // Replace a full directory with a copy twice as large, the old one
+        // may still be read by GetSlotChunk so it is kept until we are deleted
+        if(mSlotDirectorySize <= anChunkCount)
+        {
+          const Uint32 anSize = (0 == mSlotDirectorySize) ?
+            SLOT_DIRECTORY_SIZE : mSlotDirectorySize * 2;
+          std::atomic<typeSlotChunk*>* anDirectory =
+            new(std::nothrow) std::atomic<typeSlotChunk*>[anSize];
+          if(NULL == anDirectory)
+          {
+            ELOG() << "TAssetHandler(" << GetID() << "):GrowSlots() unable to "
+              << "grow the slot directory!" << std::endl;
+            return false;
+          }
+          std::atomic<typeSlotChunk*>* anOld = mSlotChunks.load(std::memory_order_relaxed);
+          for(Uint32 anIndex = 0; anIndex < anSize; anIndex++)
+          {
+            anDirectory[anIndex].store(anIndex < anChunkCount ?
+              anOld[anIndex].load(std::memory_order_relaxed) : NULL,
+              std::memory_order_relaxed);
+          }
+          mSlotChunks.store(anDirectory, std::memory_order_release);
+          mSlotDirectorySize = anSize;
+          if(NULL != anOld)
+          {
+            mRetiredDirectories.push_back(anOld);
+          }
+        }
+
+        typeSlotChunk* anChunk = new(std::nothrow) typeSlotChunk;
+        if(NULL == anChunk)
+        {
+          ELOG() << "TAssetHandler(" << GetID() << "):GrowSlots() unable to "
+            << "allocate " << POOL_CHUNK_SIZE << " more slots!" << std::endl;
+          return false;
+        }
+
+        // Every slot starts out empty before the chunk can be scanned
+        anChunk->shard = (Uint32)(&theShard - mShards);
+        for(Uint32 anIndex = 0; anIndex < POOL_CHUNK_SIZE; anIndex++)
+        {
+          anChunk->generations[anIndex] = 0;
+          anChunk->counts[anIndex] = 0;
+          anChunk->loaded[anIndex] = false;
+          anChunk->loadStyles[anIndex] = AssetLoadFromFile;
+        }
+        mSlotChunks.load(std::memory_order_relaxed)[anChunkCount].store(anChunk,
+          std::memory_order_release);
+        mSlotChunkCount.store(anChunkCount + 1, std::memory_order_release);
+
+        // Hand out the lowest slots first so records stay packed together
+        for(Uint32 anIndex = POOL_CHUNK_SIZE; anIndex > 0; anIndex--)
+        {
+          theShard.freeSlots.push_back(anChunkCount * POOL_CHUNK_SIZE + anIndex - 1);
+        }
+        return true;
+      }
+
+      /**
+       * AllocateAssetData is responsible for constructing a new Asset Data
+       * structure for theAssetID in a free slot of theShard that holds it.
+       * The lock of theShard must be held by the caller.
+       * @param[in] theShard that holds theAssetID
+       * @param[in] theAssetID the new Asset Data is for
+       * @return the new Asset Data structure or NULL if out of memory
+       */
+      typeAssetData* AllocateAssetData(typeAssetShard& theShard,
+        const AssetKey& theAssetID)
+      {
+        if(theShard.freeSlots.empty() && false == GrowSlots(theShard))
+        {
+          return NULL;
+        }
+        const Uint32 anSlot = theShard.freeSlots.back();
+        theShard.freeSlots.pop_back();
+        RaiseMaximum(mAssetsMaximum, ++mAssets);
+
+        // Construct the Asset Data bound to the hot fields of its slot
+        typeSlotChunk& anChunk = GetSlotChunk(anSlot);
+        const Uint32 anIndex = anSlot % POOL_CHUNK_SIZE;
+        typeAssetData* anResult = new(anChunk.records[anIndex].bytes) typeAssetData(
+          anSlot, anChunk.counts[anIndex], anChunk.loaded[anIndex],
+          anChunk.loadStyles[anIndex]);
+        anResult->key = theAssetID;
+        anResult->count = 0;
+        anResult->loaded = false;
+        anResult->pending = false;
+
+        // An odd generation marks the slot as holding Asset Data
+        anChunk.generations[anIndex].fetch_add(1, std::memory_order_release);
+        return anResult;
+      }
+
+      /**
+       * FreeAssetData is responsible for giving theAssetData allocated by
+       * AllocateAssetData back to our slot map. Handles to theAssetData are
+       * stale from now on. The asset it holds must already have been released
+       * and no shard lock may be held by the caller.
+       * @param[in] theAssetData to free
+       */
+      void FreeAssetData(typeAssetData* theAssetData)
+      {
+        typeAssetShard& anShard = GetShard(theAssetData->key);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+        const Uint32 anSlot = theAssetData->slot;
+        typeSlotChunk& anChunk = GetSlotChunk(anSlot);
+        const Uint32 anIndex = anSlot % POOL_CHUNK_SIZE;
+
+        // An even generation marks the slot as empty
+        anChunk.generations[anIndex].fetch_add(1, std::memory_order_release);
+        anChunk.loaded[anIndex] = false;
+        if(theAssetData->pending)
+        {
+          mPendingAssets--;
+        }
+        theAssetData->~typeAssetData();
+        anShard.freeSlots.push_back(anSlot);
+        mAssets--;
+      }
+
+      /**
+       * DeleteAssetData is responsible for releasing the asset held by
+       * theAssetData and deleting theAssetData. It must be called without
+       * holding any shard lock.
+       * @param[in] theAssetData to delete, nothing is done if NULL
+       */
+      void DeleteAssetData(typeAssetData* theAssetData)
+      {
+        if(NULL != theAssetData)
+        {
+          // The asset no longer counts against the memory budget
+          if(theAssetData->loaded)
+          {
+            mResidentBytes -= theAssetData->size;
+          }
+
+          // Nobody may share the asset once it is released
+          if(0 != theAssetData->contentHash)
+          {
+            RemoveContent(*theAssetData);
+          }
+
+          // Show the release on the timeline of this thread
+          {
+            AssetTrace::Scope anTrace("ReleaseAsset", typeid(TYPE).name(),
+              theAssetData->key);
+            ReleaseAsset(theAssetData->key.GetID(), theAssetData->acquired);
+          }
+
+          // Nobody else can reach theAssetData now, take its dependencies
+          std::vector<typeAssetDependency> anDependencies;
+          anDependencies.swap(theAssetData->dependencies);
+          typeAssetData* anContent = theAssetData->content;
+
+          // Don't keep pointers to something that has been released
+          FreeAssetData(theAssetData);
+
+          // Give back the references held to the dependencies of the asset
+          for(size_t anIndex = 0; anIndex < anDependencies.size(); anIndex++)
+          {
+            anDependencies[anIndex].handler->DropReference(anDependencies[anIndex].key);
+          }
+
+          // Give back the reference held to the asset whose TYPE was shared
+          if(NULL != anContent)
+          {
+            DropContent(anContent);
+          }
+        }
+      }
+
+      /**
+       * ClaimLoad is responsible for marking theAssetData as loading and
+       * holding a reference to it until FinishLoad is called. The shard lock
+       * for theAssetData must be held by the caller.
+       * @param[in] theAssetData to claim the load for
+       * @param[in] theCallback to call once the load completes (may be empty)
+       * @return future that will hold the result of the load
        */
-      virtual TYPE* AcquireAsset(const typeAssetID theAssetID)
+      std::shared_future<bool> ClaimLoad(typeAssetData& theAssetData,
+        typeAssetLoadCallback theCallback)
       {
-        ILOG() << "TAssetHandler(" << GetID() << "):AcquireAsset("
-          << theAssetID << ") Creating asset" << std::endl;
-        return new(std::nothrow) TYPE();
+        // Create the request that will be fulfilled by FinishLoad
+        theAssetData.request = std::make_shared<typeLoadRequest>();
+        theAssetData.request->future = theAssetData.request->promise.get_future().share();
+        theAssetData.request->started = false;
+        theAssetData.request->priority = theAssetData.priority;
+        UpdatePending(theAssetData);
+        if(theCallback)
+        {
+          theAssetData.request->callbacks.push_back(theCallback);
+        }
+
+        // Hold a reference so the asset can't be released mid load
+        theAssetData.count++;
+
+        // Forget why the previous load failed, SetLoadError may set it again
+        if(NULL != theAssetData.failure)
+        {
+          theAssetData.failure->reason.clear();
+        }
+
+        // Return the future for this load
+        return theAssetData.request->future;
       }
-      
+
       /**
-       * ReleaseAsset is responsible for unloading and removing theAsset
-       * specified and deleting the memory used by the asset.
-       * @param[in] theAssetID of the asset to be released
-       * @param[in] theAsset to be released
+       * RaiseLocked is responsible for raising the priority of theAssetData
+       * to thePriority. If its load is still waiting for a loader thread
+       * theTask is set to a copy of the load to queue at thePriority, the
+       * first copy to run does the load and the other does nothing. The
+       * shard lock for theAssetData must be held by the caller.
+       * @param[in] theAssetData to raise the priority of
+       * @param[in] thePriority (Prefetch, Visible, Critical) to raise it to
+       * @param[out] theTask to queue at thePriority, left empty if not needed
        */
-      virtual void ReleaseAsset(const typeAssetID theAssetID, TYPE* theAsset)
+      void RaiseLocked(typeAssetData& theAssetData, AssetLoadPriority thePriority,
+        AssetLoader::typeLoadTask& theTask)
       {
-        ILOG() << "TAssetHandler(" << GetID() << "):ReleaseAsset("
-          << theAssetID << ") Releasing asset" << std::endl;
+        if(theAssetData.priority < thePriority)
+        {
+          theAssetData.priority = thePriority;
+        }
 
-        // Just delete the memory used for the asset
-        delete theAsset;
+        // Only loads that are waiting for a loader thread can be sped up
+        std::shared_ptr<typeLoadRequest>& anRequest = theAssetData.request;
+        if(NULL != anRequest && false == anRequest->started &&
+          anRequest->priority < thePriority)
+        {
+          anRequest->priority = thePriority;
+          theTask = std::bind(&TAssetHandler<TYPE>::RunLoad, this, &theAssetData,
+            theAssetData.loadStyle, anRequest);
+        }
       }
 
       /**
-       * LoadFromFile is responsible for loading theAsset from a file and must
-       * be defined by the derived class since the interface for TYPE is
-       * unknown at this stage.
-       * @param[in] theAssetID of the asset to be loaded
-       * @param[in] theAsset pointer to load
-       * @return true if the asset was successfully loaded, false otherwise
+       * LoadContent is responsible for loading theAssetData claimed by
+       * ClaimLoad using theLoadStyle provided. While content sharing is
+       * enabled the asset shares the TYPE of an asset loaded from the same
+       * bytes if there is one, otherwise it is registered for others to
+       * share once it is loaded.
+       * @param[in] theAssetData claimed by ClaimLoad to be loaded
+       * @param[in] theLoadStyle to use when loading the asset
+       * @return true if the asset was loaded or shared, false otherwise
        */
-      virtual bool LoadFromFile(const typeAssetID theAssetID, TYPE& theAsset) = 0;
+      bool LoadContent(typeAssetData& theAssetData, AssetLoadStyle theLoadStyle)
+      {
+        if(mContentSharing)
+        {
+          // Hash the bytes the asset would be loaded from
+          Uint64 anHash = 0;
+          Uint64 anSize = 0;
+          bool anHashed = false;
+          {
+            AssetTrace::Scope anTrace("HashContent", typeid(TYPE).name(),
+              theAssetData.key);
+            anHashed = GetContentHash(theAssetData.key, theLoadStyle, anHash, anSize);
+          }
+
+          // Find the asset registered with the same hash or register ours
+          typeContent anContent;
+          bool anFound = false;
+          if(anHashed)
+          {
+            std::lock_guard<std::mutex> anLock(mContentMutex);
+            const typeContent* anEntry = mContents.find(anHash);
+            if(NULL != anEntry)
+            {
+              anContent = *anEntry;
+              anFound = true;
+            }
+            else
+            {
+              anContent.assetID = theAssetData.key;
+              anContent.size = anSize;
+              anContent.loadStyle = theLoadStyle;
+              mContents.insert(anHash, anContent);
+              theAssetData.contentHash = anHash;
+            }
+          }
+
+          // The hash alone may collide, only share identical bytes
+          if(anFound)
+          {
+            AssetTrace::Scope anTrace("CompareContent", typeid(TYPE).name(),
+              theAssetData.key);
+            if(anSize != anContent.size || false == CompareContent(theAssetData.key,
+              theLoadStyle, anContent.assetID, anContent.loadStyle))
+            {
+              WLOG() << "TAssetHandler(" << GetID() << "):LoadAsset("
+                << theAssetData.key << ") Content hash matches ("
+                << anContent.assetID << ") but the bytes differ" << std::endl;
+              anFound = false;
+            }
+          }
+
+          // Share its TYPE if it is or can be loaded
+          if(anFound && ShareContent(theAssetData, anContent.assetID))
+          {
+            ILOG() << "TAssetHandler(" << GetID() << "):LoadAsset("
+              << theAssetData.key << ") Sharing the content of ("
+              << anContent.assetID << ")" << std::endl;
+            mSharedLoads++;
+            return true;
+          }
+        }
+
+        // Load our own copy of the asset
+        return LoadByStyle(theAssetData.key, theLoadStyle, *theAssetData.asset);
+      }
 
       /**
-       * LoadFromMemory is responsible for loading theAsset from memory and
-       * must be defined by the derived class since the interface for TYPE is
-       * unknown at this stage.
+       * ShareContent is responsible for making theAssetData share the TYPE
+       * of theContentID, holding a reference to it until theAssetData is
+       * released. A load of theContentID in flight is waited for, unless it
+       * must be finalized on a thread the caller might be blocking.
+       * @param[in] theAssetData claimed by ClaimLoad to share the TYPE
+       * @param[in] theContentID of the asset loaded from the same bytes
+       * @return true if theAssetData shares the TYPE, false otherwise
+       */
+      bool ShareContent(typeAssetData& theAssetData, const AssetKey& theContentID)
+      {
+        // Asset whose TYPE will be shared and is it loaded yet?
+        typeAssetData* anContent = NULL;
+        bool anLoaded = false;
+
+        // Hold a reference so the asset can't be released while shared
+        {
+          typeAssetShard& anShard = GetShard(theContentID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          // An asset being reloaded is about to get different contents
+          anContent = FindAsset(anShard, theContentID);
+          if(NULL == anContent || &theAssetData == anContent ||
+            anContent->reloading)
+          {
+            return false;
+          }
+          if(0 == anContent->count++)
+          {
+            Revive(*anContent);
+          }
+          anContent->sharers++;
+          anLoaded = anContent->loaded;
+        }
+
+        // Wait for or run the load of the asset if it isn't loaded yet
+        if(false == anLoaded && false == NeedsFinalize())
+        {
+          anLoaded = LoadAsset(theContentID);
+        }
+        if(false == anLoaded)
+        {
+          DropContent(anContent);
+          return false;
+        }
+
+        // Publish the shared TYPE along with our loaded flag (see FinishLoad)
+        theAssetData.content = anContent;
+        theAssetData.asset = anContent->acquired;
+        return true;
+      }
+
+      /**
+       * DropContent is responsible for giving back the reference an asset
+       * sharing the TYPE of theContent holds (see ShareContent).
+       * @param[in] theContent whose TYPE is no longer shared by the asset
+       */
+      void DropContent(typeAssetData* theContent)
+      {
+        {
+          typeAssetShard& anShard = GetShard(theContent->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          theContent->sharers--;
+        }
+        DropReference(theContent);
+      }
+
+      /**
+       * RemoveContent is responsible for removing theAssetData from the
+       * content table so no other asset shares its TYPE from now on.
+       * @param[in] theAssetData to remove from the content table
+       */
+      void RemoveContent(typeAssetData& theAssetData)
+      {
+        std::lock_guard<std::mutex> anLock(mContentMutex);
+        const typeContent* anEntry = mContents.find(theAssetData.contentHash);
+        if(NULL != anEntry && anEntry->assetID == theAssetData.key)
+        {
+          mContents.remove(theAssetData.contentHash);
+        }
+        theAssetData.contentHash = 0;
+      }
+
+      /**
+       * LoadByStyle is responsible for calling the LoadFrom method that
+       * matches theLoadStyle provided.
        * @param[in] theAssetID of the asset to be loaded
-       * @param[in] theAsset pointer to load
+       * @param[in] theLoadStyle to use when loading the asset
+       * @param[in] theAsset to load
        * @return true if the asset was successfully loaded, false otherwise
        */
-      virtual bool LoadFromMemory(const typeAssetID theAssetID, TYPE& theAsset) = 0;
+      bool LoadByStyle(const AssetKey& theAssetID, AssetLoadStyle theLoadStyle,
+        TYPE& theAsset)
+      {
+        // Result of the load
+        bool anResult = false;
+
+        // Time the load for GetLoadNanoseconds
+        const Uint64 anStart = GetSteadyTime();
+
+        // Attempt to load the asset now using the correct style
+        switch(theLoadStyle)
+        {
+        case AssetLoadFromFile:
+          {
+            AssetTrace::Scope anTrace("LoadFromFile", typeid(TYPE).name(),
+              theAssetID);
+            anResult = LoadFromFile(theAssetID.GetID(), theAsset);
+          }
+          break;
+        case AssetLoadFromMemory:
+          {
+            AssetTrace::Scope anTrace("LoadFromMemory", typeid(TYPE).name(),
+              theAssetID);
+            anResult = LoadFromMemorySource(theAssetID, theAsset);
+          }
+          break;
+        case AssetLoadFromNetwork:
+          {
+            AssetTrace::Scope anTrace("LoadFromNetwork", typeid(TYPE).name(),
+              theAssetID);
+            anResult = LoadFromNetwork(theAssetID.GetID(), theAsset);
+          }
+          break;
+        case AssetLoadFromUnknown:
+        default:
+          ELOG() << "TAssetHandler(" << GetID() << ")::LoadAsset("
+            << theAssetID << ") unknown loading style specified!" << std::endl;
+          break;
+        }
+        const Uint64 anElapsed = GetSteadyTime() - anStart;
+        mLoadNanoseconds += anElapsed;
+
+        // Count the load for GetStats
+        mLoads++;
+        if(false == anResult)
+        {
+          mLoadFailures++;
+        }
+        RaiseMaximum(mLoadNanosecondsMaximum, anElapsed);
+        Uint32 anBucket = 0;
+        for(Uint64 anMicroseconds = anElapsed / 1000; 0 != anMicroseconds &&
+          anBucket < LOAD_TIME_BUCKETS - 1; anMicroseconds >>= 1)
+        {
+          anBucket++;
+        }
+        mLoadTimes[anBucket]++;
+
+        // Return the result of the load
+        return anResult;
+      }
+
+      /**
+       * Finalize is responsible for calling FinalizeAsset for theAsset and
+       * counting the time it takes.
+       * @param[in] theAssetID of the asset to finish
+       * @param[in] theAsset that was just loaded
+       * @return true if theAsset was finished, false otherwise
+       */
+      bool Finalize(const AssetKey& theAssetID, TYPE& theAsset)
+      {
+        AssetTrace::Scope anTrace("FinalizeAsset", typeid(TYPE).name(),
+          theAssetID);
+        const Uint64 anStart = GetSteadyTime();
+        const bool anResult = FinalizeAsset(theAssetID.GetID(), theAsset);
+        mLoadNanoseconds += GetSteadyTime() - anStart;
+        if(false == anResult)
+        {
+          SetLoadError(theAssetID, "FinalizeAsset returned false");
+        }
+        return anResult;
+      }
 
       /**
-       * LoadFromNetwork is responsible for loading theAsset from network and
-       * must be defined by the derived class since the interface for TYPE is
-       * unknown at this stage.
+       * StoreMemorySource is responsible for replacing the memory source of
+       * theAssetID with theSource provided.
+       * @param[in] theAssetID to set the memory source for
+       * @param[in] theSource to use when loading theAssetID from memory
+       */
+      void StoreMemorySource(const AssetKey& theAssetID,
+        const typeMemorySource& theSource)
+      {
+        // Find and lock the shard that holds theAssetID
+        typeAssetShard& anShard = GetShard(theAssetID);
+        std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+        // Add or replace the memory source for theAssetID
+        anShard.sources.insert(theAssetID.GetHash(), theSource);
+      }
+
+      /**
+       * FindMemorySource is responsible for finding the memory source of
+       * theAssetID, or its bytes in a mounted asset pack.
+       * @param[in] theAssetID of the asset to find
+       * @param[out] theSource found, which keeps any shared buffer alive
+       * @return true if theSource was found, false otherwise
+       */
+      bool FindMemorySource(const AssetKey& theAssetID, typeMemorySource& theSource)
+      {
+        // Find the memory source registered for theAssetID
+        {
+          typeAssetShard& anShard = GetShard(theAssetID);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          const typeMemorySource* anEntry = anShard.sources.find(theAssetID.GetHash());
+          if(NULL != anEntry)
+          {
+            theSource = *anEntry;
+            return true;
+          }
+        }
+
+        // No memory source? then try the mounted asset packs, compressed
+        // assets are decompressed into a buffer owned by theSource
+        std::vector<Uint8> anBuffer;
+        if(false == GetPackData(theAssetID, theSource.data, anBuffer))
+        {
+          return false;
+        }
+        if(false == anBuffer.empty())
+        {
+          // Swapping keeps the bytes theSource points at in place
+          std::shared_ptr<std::vector<Uint8> > anOwner =
+            std::make_shared<std::vector<Uint8> >();
+          anOwner->swap(anBuffer);
+          theSource.buffer = anOwner;
+        }
+        return true;
+      }
+
+      /**
+       * ReadContent is responsible for finding the bytes theAssetID will be
+       * loaded from with theLoadStyle, reading the whole file named by
+       * GetFilename for AssetLoadFromFile assets (see GetContentHash).
+       * @param[in] theAssetID of the asset to read
+       * @param[in] theLoadStyle the asset will be loaded with
+       * @param[out] theContent found, which keeps any buffer read alive
+       * @return true if theContent was found, false otherwise
+       */
+      bool ReadContent(const AssetKey& theAssetID, AssetLoadStyle theLoadStyle,
+        typeMemorySource& theContent)
+      {
+        // Memory sources and asset packs are used in place
+        if(AssetLoadFromMemory == theLoadStyle)
+        {
+          return FindMemorySource(theAssetID, theContent);
+        }
+        else if(AssetLoadFromFile != theLoadStyle)
+        {
+          return false;
+        }
+
+        // Read the whole file into a buffer owned by theContent
+        std::ifstream anFile(GetFilename(theAssetID).c_str(),
+          std::ios::in | std::ios::binary);
+        if(false == anFile.is_open())
+        {
+          return false;
+        }
+        anFile.seekg(0, std::ios::end);
+        const std::streamoff anSize = anFile.tellg();
+        anFile.seekg(0, std::ios::beg);
+        if(anSize < 0)
+        {
+          return false;
+        }
+        std::shared_ptr<std::vector<Uint8> > anBytes =
+          std::make_shared<std::vector<Uint8> >((size_t)anSize);
+        if(0 != anSize && anFile.read((char*)&(*anBytes)[0], anSize).fail())
+        {
+          return false;
+        }
+        theContent.buffer = anBytes;
+        theContent.data.data = anBytes->empty() ? NULL : &(*anBytes)[0];
+        theContent.data.size = (Uint64)anBytes->size();
+        return true;
+      }
+
+      /**
+       * LoadFromMemorySource is responsible for finding the memory source of
+       * theAssetID, or its bytes in a mounted asset pack, and handing them
+       * to LoadFromMemory.
        * @param[in] theAssetID of the asset to be loaded
-       * @param[in] theAsset pointer to load
+       * @param[in] theAsset to load
        * @return true if the asset was successfully loaded, false otherwise
        */
-      virtual bool LoadFromNetwork(const typeAssetID theAssetID, TYPE& theAsset) = 0;
+      bool LoadFromMemorySource(const AssetKey& theAssetID, TYPE& theAsset)
+      {
+        // Copy of the memory source, which keeps any shared buffer alive
+        typeMemorySource anSource;
 
-    private:
-      // Structures
-      ///////////////////////////////////////////////////////////////////////////
-      /// Structure holding information about each Resource
-      struct typeAssetData {
-        TYPE*          asset;     ///< The asset being shared
-        std::string    filename;  ///< Filename to use when loading this asset
-        AssetLoadStyle loadStyle; ///< Load type (File, Memory, Network, etc)
-        AssetLoadTime  loadTime;  ///< Load time (Now, later)
-        AssetDropTime  dropTime;  ///< Drop time at (Zero, Exit)
-        Uint32         count;     ///< Number of people referencing this Asset
-        bool           loaded;    ///< Is the Asset currently loaded?
-        char           pad_[7];   ///< Padding
-      };
+        // Nothing to load from? log an error
+        if(false == FindMemorySource(theAssetID, anSource))
+        {
+          ELOG() << "TAssetHandler(" << GetID() << ")::LoadFromMemory("
+            << theAssetID << ") No memory source or asset pack entry found!"
+            << std::endl;
+          SetLoadError(theAssetID, "No memory source or asset pack entry found");
+          return false;
+        }
 
-      // Variables
-      ///////////////////////////////////////////////////////////////////////////
-      /// Map that associates asset ID's with their appropriate TAssetData
-      std::map<const typeAssetID, typeAssetData> mAssets;
-      /// Dummy asset that will be returned if an asset can't be Acquired
-      TYPE mDummyAsset;
+        // Return the result of loading straight from the bytes found
+        return LoadFromMemory(theAssetID.GetID(), anSource.data, theAsset);
+      }
+
+      /**
+       * RunLoad is the task run by the loader threads for LoadAssetAsync.
+       * AssetLoadPrefetch loads that nobody references anymore by the time
+       * they start are cancelled instead.
+       * @param[in] theAssetData claimed by ClaimLoad to be loaded
+       * @param[in] theLoadStyle to use when loading the asset
+       * @param[in] theRequest of the claim, shared by every queued copy
+       */
+      void RunLoad(typeAssetData* theAssetData, AssetLoadStyle theLoadStyle,
+        std::shared_ptr<typeLoadRequest> theRequest)
+      {
+        // Did a copy queued by RaisePriority already run? then theAssetData
+        // may be gone and there is nothing left to do
+        if(theRequest->started.exchange(true))
+        {
+          return;
+        }
+
+        // Cancel prefetches whose only reference left is our claim
+        bool anCancel = false;
+        {
+          typeAssetShard& anShard = GetShard(theAssetData->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          anCancel = AssetLoadPrefetch == theRequest->priority &&
+            1 == theAssetData->count;
+        }
+        if(anCancel)
+        {
+          ILOG() << "TAssetHandler(" << GetID() << "):RunLoad("
+            << theAssetData->key << ") Unused prefetch cancelled" << std::endl;
+          FinishLoad(theAssetData, false, true);
+          return;
+        }
+
+        const bool anLoaded = LoadContent(*theAssetData, theLoadStyle);
+
+        // Leave assets that must be finalized for FinalizeLoads, the load
+        // stays in flight with our claim until then
+        if(anLoaded && NeedsFinalize() && NULL == theAssetData->content)
+        {
+          std::lock_guard<std::mutex> anLock(mFinalizeMutex);
+          mFinalizes.push_back(theAssetData);
+          return;
+        }
+        FinishLoad(theAssetData, anLoaded);
+      }
+
+      /**
+       * RunReload is the task run by the loader threads for ReloadFile. The
+       * asset is loaded into a fresh TYPE and queued for FinishReloads.
+       * @param[in] theAssetData held by ReloadFile to be reloaded
+       */
+      void RunReload(typeAssetData* theAssetData)
+      {
+        typeReload anReload;
+        anReload.assetData = theAssetData;
+        anReload.loaded = false;
+
+        // Acquire the fresh asset the same way GetReference does
+        {
+          typeAssetShard& anShard = GetShard(theAssetData->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+          anReload.asset = AcquireAsset(theAssetData->key.GetID());
+        }
+
+        // Load the fresh asset without disturbing the one in use
+        if(NULL != anReload.asset)
+        {
+          anReload.loaded = LoadByStyle(theAssetData->key, AssetLoadFromFile,
+            *anReload.asset);
+        }
+
+        std::lock_guard<std::mutex> anLock(mReloadMutex);
+        mReloads.push_back(anReload);
+      }
+
+      /**
+       * RaiseMaximum is responsible for raising theMaximum to theValue if
+       * theValue is larger, without a lock.
+       * @param[in] theMaximum to raise
+       * @param[in] theValue that might be the new maximum
+       */
+      static void RaiseMaximum(std::atomic<Uint64>& theMaximum, Uint64 theValue)
+      {
+        Uint64 anMaximum = theMaximum.load(std::memory_order_relaxed);
+        while(anMaximum < theValue &&
+          false == theMaximum.compare_exchange_weak(anMaximum, theValue))
+        {
+        }
+      }
+
+      /**
+       * GetSteadyTime will return the current steady clock time in
+       * nanoseconds, used for the lock free retry time of each asset.
+       * @return the steady clock time in nanoseconds
+       */
+      static Uint64 GetSteadyTime(void)
+      {
+        return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+      }
+
+      /**
+       * RecordFailure is responsible for noting another failed load of
+       * theAssetData and choosing when it may be loaded again. The shard lock
+       * for theAssetData must be held by the caller.
+       * @param[in] theAssetData that failed to load
+       */
+      void RecordFailure(typeAssetData& theAssetData)
+      {
+        if(NULL == theAssetData.failure)
+        {
+          theAssetData.failure.reset(new typeLoadFailure());
+          theAssetData.failure->failures = 0;
+        }
+        typeLoadFailure& anFailure = *theAssetData.failure;
+        anFailure.failures++;
+        anFailure.time = std::chrono::steady_clock::now();
+        if(anFailure.reason.empty())
+        {
+          anFailure.reason = "Load returned false";
+        }
+
+        // Double the delay after each failure in a row up to the maximum
+        const Uint64 anMaximum = mRetryDelayMaximum;
+        Uint64 anDelay = mRetryDelay;
+        for(Uint32 anIndex = 1; anIndex < anFailure.failures && anDelay < anMaximum; anIndex++)
+        {
+          anDelay *= 2;
+        }
+        anDelay = (anDelay < anMaximum) ? anDelay : anMaximum;
+
+        if(0 == mRetryDelay)
+        {
+          // Only RetryAsset may load it again
+          anFailure.retryTime = std::chrono::steady_clock::time_point::max();
+          theAssetData.retryTime = RETRY_NEVER;
+        }
+        else
+        {
+          anFailure.retryTime = anFailure.time + std::chrono::milliseconds(anDelay);
+          theAssetData.retryTime = (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            anFailure.retryTime.time_since_epoch()).count();
+        }
+
+        WLOG() << "TAssetHandler(" << GetID() << "):LoadAsset("
+          << theAssetData.key << ") failed " << anFailure.failures << " time(s) ("
+          << anFailure.reason << "), retry in "
+          << (0 == mRetryDelay ? 0 : anDelay) << "ms" << std::endl;
+      }
+
+      /**
+       * FinishLoad is responsible for publishing theLoaded result for
+       * theAssetData, notifying everyone waiting on the load and dropping the
+       * reference taken by ClaimLoad.
+       * @param[in] theAssetData claimed by ClaimLoad that was loaded
+       * @param[in] theLoaded result of the load
+       * @param[in] theCancelled true if the load was cancelled, not failed
+       */
+      void FinishLoad(typeAssetData* theAssetData, bool theLoaded,
+        bool theCancelled = false)
+      {
+        // Request to fulfill once the shard lock is released
+        std::shared_ptr<typeLoadRequest> anRequest;
+
+        // Measure the loaded asset, nobody else touches it until published,
+        // a shared TYPE is already counted by the asset that loaded it
+        const Uint64 anSize = (theLoaded && NULL == theAssetData->content) ?
+          GetAssetSize(*theAssetData->asset) : 0;
+
+        // Nobody may share an asset that failed to load
+        if(false == theLoaded && 0 != theAssetData->contentHash)
+        {
+          RemoveContent(*theAssetData);
+        }
+
+        // Publish the result, the lock makes the loaded asset visible to others
+        {
+          typeAssetShard& anShard = GetShard(theAssetData->key);
+          std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+          // Our reference guarantees theAssetData still exists
+          theAssetData->size = anSize;
+          theAssetData->loaded = theLoaded;
+          anRequest.swap(theAssetData->request);
+
+          // Remember the failure so the asset isn't loaded again right away
+          if(theLoaded)
+          {
+            theAssetData->failure.reset();
+            theAssetData->retryTime = 0;
+          }
+          else if(false == theCancelled)
+          {
+            RecordFailure(*theAssetData);
+          }
+          UpdatePending(*theAssetData);
+        }
+
+        // Let everyone waiting on the load know the result
+        anRequest->promise.set_value(theLoaded);
+        for(size_t anIndex = 0; anIndex < anRequest->callbacks.size(); anIndex++)
+        {
+          anRequest->callbacks[anIndex](theAssetData->key.GetID(), theLoaded);
+        }
+
+        // Count the loaded asset against the memory budget
+        RaiseMaximum(mResidentBytesMaximum, mResidentBytes += anSize);
+
+        // Give back the reference taken by ClaimLoad
+        DropReference(theAssetData);
+      }
   }; // class TAssetHandler
 } // namespace GExL
 
@@ -809,7 +3838,33 @@ namespace GExL
  * @class GExL::TAssetHandler
  * @ingroup Core
  * The TAssetHandler template class is used to quickly provide a IAssetHandler
- * derived class for handling the Asset type specified.
+ * derived class for handling the Asset type specified. The asset table is
+ * split into SHARD_COUNT shards chosen by the hash of each asset ID and each
+ * shard has its own lock, so GetReference and DropReference may be called
+ * from multiple threads at once with little contention. Assets are looked
+ * up by AssetKey in an open addressing THashTable so no asset ID strings
+ * are compared or copied once a key has been created. Loading is done
+ * outside of the shard locks so derived LoadFromFile methods may safely call
+ * back into GetFilename and friends. Assets loaded with AssetLoadFromMemory
+ * are handed the bytes registered with SetMemorySource, or found in the
+ * asset packs mounted on the AssetManager, without any copies. Assets
+ * dropped with AssetDropLRU stay loaded in a least recently used cache once
+ * unused and are only released when the handler or AssetManager memory
+ * budget is exceeded. ReloadFile reloads assets whose file changed into a
+ * fresh TYPE on the loader threads and FinishReloads swaps the contents in
+ * place so the TYPE address each TAsset holds stays valid. Failed loads are
+ * remembered with their reason (see GetLoadFailure) and the asset is not
+ * loaded again until its retry delay has passed, doubling after each failure
+ * in a row, so a missing asset drawn every frame costs no file access.
+ * Handlers whose assets must be finished on one thread, such as textures
+ * created with a renderer, override NeedsFinalize and FinalizeAsset so the
+ * loader threads only decode each asset and FinalizeLoads finishes it.
+ * Assets that need other assets, such as a font and its texture atlas, call
+ * AddDependency so the dependency stays loaded while the asset is and
+ * AssetManager::LoadGraph loads the dependency first. SetContentSharing
+ * makes assets registered under different IDs but loaded from identical
+ * bytes share one loaded TYPE, so a sprite exported under several names is
+ * only loaded and kept in memory once.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -0,0 +1,376 @@
+/**
+ * Provides the templatized data type of an open addressing hash table keyed
+ * by 64 bit hash values.
+ *
+ * @file include/GExL/container/THashTable.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_THASH_TABLE_HPP_INCLUDED
+#define   CORE_THASH_TABLE_HPP_INCLUDED
+
+#include <GExL/GExL_types.hpp>
+#include <GExL/logger/Log_macros.hpp>
+#include <new>
+
+namespace GExL
+{
+  /**
+   * @brief Provides an open addressing hash table in a templatized format.
+   * @details Items are stored directly in a single power of two sized array
+   * of slots and are found by linear probing from the slot chosen by the low
+   * bits of the key, so a lookup is usually a single cache line read. Keys
+   * are expected to already be well mixed 64 bit hash values (see AssetKey).
+   * Example usage:
+   *   GExL::THashTable<int> table;
+   *   table.insert(HashAssetID("hero"), 10);
+   *
+   *   int* value = table.find(HashAssetID("hero"));
+   *
+   *   for(GExL::Uint32 i=0; i<table.capacity(); ++i)
+   *     if(table.isUsed(i))
+   *       printf("%llu = %d\n", table.keyAt(i), table.itemAt(i));
+   */
+  template <class TYPE>
+  class THashTable
+  {
+  public:
+    /** Default constructor creates an empty THashTable with room for at
+     * least capacity items before it needs to grow.
+     * @param[in] capacity to reserve (rounded up to a power of two)
+     * @throws std::bad_alloc if the slots can't be allocated
+     */
+    explicit THashTable(Uint32 capacity = 16);
+
+    /** Destructor for hash table will delete every slot (not the items
+     * pointed to if TYPE is a pointer).
+     */
+    virtual ~THashTable();
+
+    /** Retrieve the number of items stored in the hash table.
+     * @return Uint32
+     *   number of items stored
+     */
+    Uint32 size() const;
+
+    /** Retrieve the number of slots in the hash table. Typically used when
+     * iterating over every slot with isUsed, keyAt and itemAt.
+     * @return Uint32
+     *   number of slots
+     */
+    Uint32 capacity() const;
+
+    /** Find the item stored under the key provided.
+     * @param[in] key to find
+     * @return TYPE*
+     *   pointer to the item found or 0 if key isn't stored
+     */
+    TYPE* find(Uint64 key);
+
+    /** Find the item stored under the key provided.
+     * @param[in] key to find
+     * @return TYPE const*
+     *   constant pointer to the item found or 0 if key isn't stored
+     */
+    TYPE const* find(Uint64 key) const;
+
+    /** Store item under the key provided, replacing any item already stored
+     * under the same key. The table is grown before it becomes too full.
+     * If growing fails std::bad_alloc is thrown and the table is left as it
+     * was before the call.
+     * @param[in] key to store item under
+     * @param[in] item to store
+     * @return TYPE&
+     *   reference to the item stored in the table
+     */
+    TYPE& insert(Uint64 key, TYPE const& item);
+
+    /** Remove the item stored under the key provided. Items that follow in
+     * the same probe sequence are shifted back so no tombstones are needed.
+     * @param[in] key to remove
+     * @return true if key was found and removed, false otherwise
+     */
+    bool remove(Uint64 key);
+
+    /** Remove every item stored in the hash table.
+     */
+    void clear();
+
+    /** Determine if the slot at position holds an item.
+     * @param[in] position of the slot to check
+     * @return true if the slot holds an item, false otherwise
+     */
+    bool isUsed(Uint32 position) const;
+
+    /** Retrieve the key of the slot at position.
+     * @param[in] position of the slot
+     * @return Uint64
+     *   key stored in the slot
+     */
+    Uint64 keyAt(Uint32 position) const;
+
+    /** Retrieve a reference to the item in the slot at position.
+     * @param[in] position of the slot
+     * @return TYPE&
+     *   reference to the item stored in the slot
+     */
+    TYPE& itemAt(Uint32 position);
+
+  private:
+    /** Structure holding a single slot of the hash table
+     */
+    struct typeSlot {
+      Uint64 key;  ///< Key of the item stored in this slot
+      TYPE   item; ///< Item stored in this slot
+      bool   used; ///< Does this slot hold an item?
+    };
+
+    /** Array of slots, always a power of two in size
+     */
+    typeSlot* mSlots;
+
+    /** Number of slots minus one, used to wrap slot positions
+     */
+    Uint32 mMask;
+
+    /** Number of items stored in the slots
+     */
+    Uint32 mSize;
+
+    /** Helper function used to find the slot for key or the empty slot where
+     * key would be stored.
+     * @param[in] key to find
+     * @return Uint32
+     *   position of the slot found
+     */
+    Uint32 probe(Uint64 key) const;
+
+    /** Helper function used to move every item into a larger slot array.
+     * @param[in] capacity of the new slot array (must be a power of two)
+     */
+    void grow(Uint32 capacity);
+
+    /** Our copy constructor is private because we do not allow copies of our
+     * class
+     */
+    THashTable(THashTable const&); // Intentionally undefined
+
+    /** Our assignment operator is private because we do not allow copies of
+     * our class
+     */
+    THashTable& operator=(THashTable const&); // Intentionally undefined
+  }; // class THashTable
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Template implementation details
+  /////////////////////////////////////////////////////////////////////////////
+  template <class TYPE>
+  THashTable<TYPE>::THashTable(Uint32 capacity) :
+    mSlots(0),
+    mMask(0U),
+    mSize(0U)
+  {
+    // Round capacity up to the next power of two
+    Uint32 anCapacity = 2U;
+    while(anCapacity < capacity)
+    {
+      anCapacity <<= 1;
+    }
+
+    mSlots = new typeSlot[anCapacity];
+    mMask = anCapacity - 1;
+    for(Uint32 i = 0; i < anCapacity; ++i)
+    {
+      mSlots[i].used = false;
+    }
+  }
+
+  template <class TYPE>
+  THashTable<TYPE>::~THashTable()
+  {
+    delete[] mSlots;
+
+    // Don't keep slot address around
+    mSlots = 0;
+    mSize = 0U;
+  }
+
+  template <class TYPE>
+  Uint32 THashTable<TYPE>::size() const
+  {
+    return mSize;
+  }
+
+  template <class TYPE>
+  Uint32 THashTable<TYPE>::capacity() const
+  {
+    return mMask + 1;
+  }
+
+  template <class TYPE>
+  TYPE* THashTable<TYPE>::find(Uint64 key)
+  {
+    Uint32 anPosition = probe(key);
+    return mSlots[anPosition].used ? &mSlots[anPosition].item : 0;
+  }
+
+  template <class TYPE>
+  TYPE const* THashTable<TYPE>::find(Uint64 key) const
+  {
+    Uint32 anPosition = probe(key);
+    return mSlots[anPosition].used ? &mSlots[anPosition].item : 0;
+  }
+
+  template <class TYPE>
+  TYPE& THashTable<TYPE>::insert(Uint64 key, TYPE const& item)
+  {
+    // Keep the table at most 3/4 full so probe sequences stay short
+    if((mSize + 1) * 4 > (mMask + 1) * 3)
+    {
+      grow((mMask + 1) * 2);
+    }
+
+    Uint32 anPosition = probe(key);
+    if(false == mSlots[anPosition].used)
+    {
+      mSlots[anPosition].key = key;
+      mSlots[anPosition].used = true;
+      mSize++;
+    }
+    mSlots[anPosition].item = item;
+
+    return mSlots[anPosition].item;
+  }
+
+  template <class TYPE>
+  bool THashTable<TYPE>::remove(Uint64 key)
+  {
+    Uint32 anPosition = probe(key);
+    if(false == mSlots[anPosition].used)
+    {
+      return false;
+    }
+
+    // Shift back each following item that would have preferred the hole
+    Uint32 anNext = (anPosition + 1) & mMask;
+    while(mSlots[anNext].used)
+    {
+      Uint32 anHome = (Uint32)mSlots[anNext].key & mMask;
+
+      // Can the item at anNext be found from its home if moved into the hole?
+      if(((anNext - anHome) & mMask) >= ((anNext - anPosition) & mMask))
+      {
+        mSlots[anPosition].key = mSlots[anNext].key;
+        mSlots[anPosition].item = mSlots[anNext].item;
+        anPosition = anNext;
+      }
+      anNext = (anNext + 1) & mMask;
+    }
+
+    // The last hole is now empty
+    mSlots[anPosition].item = TYPE();
+    mSlots[anPosition].used = false;
+    mSize--;
+
+    return true;
+  }
+
+  template <class TYPE>
+  void THashTable<TYPE>::clear()
+  {
+    for(Uint32 i = 0; i <= mMask; ++i)
+    {
+      mSlots[i].item = TYPE();
+      mSlots[i].used = false;
+    }
+    mSize = 0U;
+  }
+
+  template <class TYPE>
+  bool THashTable<TYPE>::isUsed(Uint32 position) const
+  {
+    return position <= mMask && mSlots[position].used;
+  }
+
+  template <class TYPE>
+  Uint64 THashTable<TYPE>::keyAt(Uint32 position) const
+  {
+    return mSlots[position & mMask].key;
+  }
+
+  template <class TYPE>
+  TYPE& THashTable<TYPE>::itemAt(Uint32 position)
+  {
+    return mSlots[position & mMask].item;
+  }
+
+  template <class TYPE>
+  Uint32 THashTable<TYPE>::probe(Uint64 key) const
+  {
+    // Start at the home slot and walk forward until key or a hole is found
+    Uint32 anPosition = (Uint32)key & mMask;
+    while(mSlots[anPosition].used && mSlots[anPosition].key != key)
+    {
+      anPosition = (anPosition + 1) & mMask;
+    }
+    return anPosition;
+  }
+
+  template <class TYPE>
+  void THashTable<TYPE>::grow(Uint32 capacity)
+  {
+    // Create the larger slot array before touching the current one so a
+    // failed allocation leaves the table unchanged
+    typeSlot* anNewSlots = new typeSlot[capacity];
+    typeSlot* anSlots = mSlots;
+    Uint32 anCapacity = mMask + 1;
+    mSlots = anNewSlots;
+    mMask = capacity - 1;
+    for(Uint32 i = 0; i < capacity; ++i)
+    {
+      mSlots[i].used = false;
+    }
+
+    // Move each item into its new slot
+    for(Uint32 i = 0; i < anCapacity; ++i)
+    {
+      if(anSlots[i].used)
+      {
+        Uint32 anPosition = probe(anSlots[i].key);
+        mSlots[anPosition].key = anSlots[i].key;
+        mSlots[anPosition].item = anSlots[i].item;
+        mSlots[anPosition].used = true;
+      }
+    }
+
+    delete[] anSlots;
+  }
+} // namespace GExL
+
+#endif // CORE_THASH_TABLE_HPP_INCLUDED
+
+/**
+ * @class GExL::THashTable
+ * @ingroup Core
+ * The THashTable template class is the template used to create an open
+ * addressing hash table of the type provided, keyed by 64 bit hash values.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
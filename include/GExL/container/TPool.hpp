@@ -0,0 +1,259 @@
+/**
+ * Provides the templatized data type of a pool allocating items from large
+ * chunks with stable addresses.
+ *
+ * @file include/GExL/container/TPool.hpp
+ * @author Jacob Dix
+ * @date 20261017 - Initial Release
+ */
+#ifndef   CORE_TPOOL_HPP_INCLUDED
+#define   CORE_TPOOL_HPP_INCLUDED
+
+#include <GExL/GExL_types.hpp>
+#include <GExL/logger/Log_macros.hpp>
+#include <new>
+
+namespace GExL
+{
+  /**
+   * @brief Provides a slab pool of items in a templatized format.
+   * @details Items are constructed in place inside chunks of chunkSize slots
+   * each and are never moved, so pointers returned by acquire stay valid
+   * until the item is released. Released slots are kept on a free list and
+   * reused by the next acquire, chunks are only given back when the pool is
+   * deleted. This turns one allocator call per item into one allocator call
+   * per chunk and keeps items allocated together next to each other.
+   * Example usage:
+   *   GExL::TPool<Sound> pool;
+   *   Sound* sound = pool.acquire();
+   *
+   *   pool.release(sound);
+   */
+  template <class TYPE>
+  class TPool
+  {
+  public:
+    /** Default constructor creates an empty TPool, no memory is allocated
+     * until the first item is acquired.
+     * @param[in] chunkSize is the number of items allocated at once
+     */
+    explicit TPool(Uint32 chunkSize = 64);
+
+    /** Destructor for pool will delete every chunk. Every item must have
+     * been released before the pool is deleted, items still acquired are
+     * not deconstructed.
+     */
+    virtual ~TPool();
+
+    /** Retrieve the number of items currently acquired from the pool.
+     * @return Uint32
+     *   number of items acquired
+     */
+    Uint32 size() const;
+
+    /** Retrieve the number of items the chunks allocated so far can hold.
+     * @return Uint32
+     *   number of slots
+     */
+    Uint32 capacity() const;
+
+    /** Construct a new item in a free slot, allocating a new chunk if no
+     * slot is free.
+     * @return TYPE*
+     *   pointer to the item constructed or 0 if no memory is available
+     */
+    TYPE* acquire();
+
+    /** Deconstruct item and return its slot to the free list.
+     * @param[in] item acquired from this pool to release, ignored if 0
+     */
+    void release(TYPE* item);
+
+  private:
+    /** Slot holding either an item or the next free slot
+     */
+    union typeSlot {
+      typeSlot*          next;               ///< Next free slot when unused
+      alignas(TYPE) char item[sizeof(TYPE)]; ///< Storage for the item when used
+    };
+
+    /** Structure holding each chunk of slots allocated
+     */
+    struct typeChunk {
+      typeChunk* next;  ///< Next chunk allocated
+      typeSlot*  slots; ///< First slot of this chunk
+    };
+
+    /** Singly linked list of every chunk allocated
+     */
+    typeChunk* mChunks;
+
+    /** Singly linked list of every free slot
+     */
+    typeSlot* mFree;
+
+    /** Number of slots allocated in each chunk
+     */
+    Uint32 mChunkSize;
+
+    /** Number of items currently acquired
+     */
+    Uint32 mSize;
+
+    /** Number of slots in every chunk allocated so far
+     */
+    Uint32 mCapacity;
+
+    /** Helper function used to allocate a new chunk and add its slots to the
+     * free list.
+     * @return true if the chunk was allocated, false otherwise
+     */
+    bool grow();
+
+    /** Our copy constructor is private because we do not allow copies of our
+     * class
+     */
+    TPool(TPool const&); // Intentionally undefined
+
+    /** Our assignment operator is private because we do not allow copies of
+     * our class
+     */
+    TPool& operator=(TPool const&); // Intentionally undefined
+  }; // class TPool
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Template implementation details
+  /////////////////////////////////////////////////////////////////////////////
+  template <class TYPE>
+  TPool<TYPE>::TPool(Uint32 chunkSize) :
+    mChunks(0),
+    mFree(0),
+    mChunkSize(0 == chunkSize ? 1U : chunkSize),
+    mSize(0U),
+    mCapacity(0U)
+  {
+  }
+
+  template <class TYPE>
+  TPool<TYPE>::~TPool()
+  {
+    if(0 != mSize)
+    {
+      WLOG() << "TPool::dtor() " << mSize << " items were never released"
+        << std::endl;
+    }
+
+    // Delete every chunk
+    while(0 != mChunks)
+    {
+      typeChunk* anChunk = mChunks;
+      mChunks = anChunk->next;
+      delete[] anChunk->slots;
+      delete anChunk;
+    }
+
+    // Don't keep slot addresses around
+    mFree = 0;
+    mSize = 0U;
+    mCapacity = 0U;
+  }
+
+  template <class TYPE>
+  Uint32 TPool<TYPE>::size() const
+  {
+    return mSize;
+  }
+
+  template <class TYPE>
+  Uint32 TPool<TYPE>::capacity() const
+  {
+    return mCapacity;
+  }
+
+  template <class TYPE>
+  TYPE* TPool<TYPE>::acquire()
+  {
+    // Allocate another chunk if every slot is in use
+    if(0 == mFree && false == grow())
+    {
+      return 0;
+    }
+
+    // Take the first free slot and construct the item in it
+    typeSlot* anSlot = mFree;
+    mFree = anSlot->next;
+    mSize++;
+    return new(anSlot->item) TYPE();
+  }
+
+  template <class TYPE>
+  void TPool<TYPE>::release(TYPE* item)
+  {
+    if(0 != item)
+    {
+      item->~TYPE();
+
+      // Put the slot at the front of the free list so it is reused next
+      typeSlot* anSlot = reinterpret_cast<typeSlot*>(item);
+      anSlot->next = mFree;
+      mFree = anSlot;
+      mSize--;
+    }
+  }
+
+  template <class TYPE>
+  bool TPool<TYPE>::grow()
+  {
+    typeChunk* anChunk = new (std::nothrow) typeChunk;
+    if(0 == anChunk)
+    {
+      return false;
+    }
+    anChunk->slots = new (std::nothrow) typeSlot[mChunkSize];
+    if(0 == anChunk->slots)
+    {
+      delete anChunk;
+      return false;
+    }
+    anChunk->next = mChunks;
+    mChunks = anChunk;
+    mCapacity += mChunkSize;
+
+    // Link the slots in address order so items are handed out in order
+    for(Uint32 i = mChunkSize; i > 0; --i)
+    {
+      anChunk->slots[i - 1].next = mFree;
+      mFree = &anChunk->slots[i - 1];
+    }
+    return true;
+  }
+} // namespace GExL
+
+#endif // CORE_TPOOL_HPP_INCLUDED
+
+/**
+ * @class GExL::TPool
+ * @ingroup Core
+ * The TPool template class is the template used to create a slab pool of the
+ * type provided. It is not thread safe, callers sharing a pool between
+ * threads must hold their own lock around acquire and release.
+ *
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -27,6 +27,13 @@ namespace GExL
   * @return theString with all uppercase.
   **/
   std::string GExL_API StringToUppercase(std::string theString);
+
+  /** 
+  * StringToJSON will quote theString and escape it for use in JSON.
+  * @param[in] theString is the string to convert.
+  * @return theString as a quoted and escaped JSON string.
+  **/
+  std::string GExL_API StringToJSON(const std::string& theString);
   /**
   * GetDateString will generated a string with the current date.
   * @return A string containing todays date in MM/DD/YY format.
@@ -0,0 +1,177 @@
+/**
+* Provides the AssetGroup class in the GExL namespace which is responsible
+* for holding the references of a batch of assets loaded together by
+* AssetManager::LoadGroup.
+*
+* @file src/GExL/assets/AssetGroup.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <fstream>
+#include <sstream>
+#include <GExL/assets/AssetGroup.hpp>
+#include <GExL/assets/IAssetHandler.hpp>
+#include <GExL/logger/Log_macros.hpp>
+
+namespace GExL
+{
+  AssetGroup::AssetGroup()
+  {
+    ILOGM("AssetGroup::ctor()");
+  }
+
+  AssetGroup::~AssetGroup()
+  {
+    ILOGM("AssetGroup::dtor()");
+
+    // Give back every reference still held
+    Release();
+  }
+
+  Uint32 AssetGroup::GetCount(void) const
+  {
+    return (Uint32)mAssets.size();
+  }
+
+  Uint32 AssetGroup::GetLoadedCount(void) const
+  {
+    // Number of loads that finished successfully
+    Uint32 anResult = 0;
+
+    for(size_t anIndex = 0; anIndex < mAssets.size(); anIndex++)
+    {
+      const std::shared_future<bool>& anFuture = mAssets[anIndex].future;
+      if(anFuture.valid() && std::future_status::ready ==
+        anFuture.wait_for(std::chrono::seconds(0)) && anFuture.get())
+      {
+        anResult++;
+      }
+    }
+
+    // Return the number of assets loaded so far
+    return anResult;
+  }
+
+  bool AssetGroup::IsDone(void) const
+  {
+    for(size_t anIndex = 0; anIndex < mAssets.size(); anIndex++)
+    {
+      const std::shared_future<bool>& anFuture = mAssets[anIndex].future;
+      if(anFuture.valid() && std::future_status::ready !=
+        anFuture.wait_for(std::chrono::seconds(0)))
+      {
+        return false;
+      }
+    }
+
+    // Return true, nothing is still being loaded
+    return true;
+  }
+
+  bool AssetGroup::Wait(void) const
+  {
+    // Return true if every asset was loaded
+    bool anResult = true;
+
+    for(size_t anIndex = 0; anIndex < mAssets.size(); anIndex++)
+    {
+      const std::shared_future<bool>& anFuture = mAssets[anIndex].future;
+      if(false == anFuture.valid())
+      {
+        anResult = false;
+        continue;
+      }
+
+      // Finalize loads while waiting if this thread finalizes them
+      if(mAssets[anIndex].handler->IsFinalizeThread())
+      {
+        while(std::future_status::ready != anFuture.wait_for(std::chrono::milliseconds(1)))
+        {
+          mAssets[anIndex].handler->FinalizeLoads();
+        }
+      }
+      anResult &= anFuture.get();
+    }
+
+    // Return anResult which is true if every asset was loaded
+    return anResult;
+  }
+
+  void AssetGroup::Release(void)
+  {
+    // Drop our reference to each asset, loads in flight hold their own
+    for(size_t anIndex = 0; anIndex < mAssets.size(); anIndex++)
+    {
+      typeGroupAsset& anAsset = mAssets[anIndex];
+      anAsset.handler->DropReference(anAsset.key, anAsset.dropTime);
+    }
+    mAssets.clear();
+  }
+
+  bool AssetGroup::ReadManifest(const std::string& theFilename,
+    std::vector<typeManifestEntry>& theManifest)
+  {
+    std::ifstream anFile(theFilename.c_str());
+    if(false == anFile.is_open())
+    {
+      ELOG() << "AssetGroup::ReadManifest(" << theFilename
+        << ") unable to open manifest!" << std::endl;
+      return false;
+    }
+
+    // Read each "handlerID assetID [priority]" line
+    std::string anLine;
+    Uint32 anLineNumber = 0;
+    while(std::getline(anFile, anLine))
+    {
+      anLineNumber++;
+
+      // Skip empty lines and comments
+      std::istringstream anStream(anLine);
+      typeManifestEntry anEntry;
+      if(!(anStream >> anEntry.handlerID) || '#' == anEntry.handlerID[0])
+      {
+        continue;
+      }
+
+      if(!(anStream >> anEntry.assetID))
+      {
+        WLOG() << "AssetGroup::ReadManifest(" << theFilename << ") line "
+          << anLineNumber << " has no asset ID" << std::endl;
+        continue;
+      }
+
+      // Priority is optional
+      if(!(anStream >> anEntry.priority))
+      {
+        anEntry.priority = 0;
+      }
+      theManifest.push_back(anEntry);
+    }
+
+    // Return true, the manifest was read
+    return true;
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
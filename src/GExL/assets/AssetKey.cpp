@@ -0,0 +1,196 @@
+/**
+* Provides the AssetKey class in the GExL namespace which is an interned 64
+* bit handle for an asset ID string.
+*
+* @file src/GExL/assets/AssetKey.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <GExL/assets/AssetKey.hpp>
+#include <GExL/logger/Log_macros.hpp>
+
+namespace GExL
+{
+  namespace
+  {
+    /// Number of independently locked shards the string table is split into
+    const size_t INTERN_SHARD_COUNT = 16;
+
+    /// Structure holding one independently locked portion of the string table
+    struct typeInternShard {
+      std::mutex mutex; ///< Lock protecting the strings map below
+      /// Map of hash to interned asset ID, nodes never move once inserted
+      std::unordered_map<Uint64, typeAssetID> strings;
+    };
+
+    /**
+     * GetInternShard will return the string table shard for theHash. The
+     * table is never deleted so keys held by static objects stay valid
+     * while the application exits.
+     * @param[in] theHash to find the shard for
+     * @return the shard that theHash belongs to
+     */
+    typeInternShard& GetInternShard(Uint64 theHash)
+    {
+      static typeInternShard* sShards = new typeInternShard[INTERN_SHARD_COUNT];
+      return sShards[(theHash >> 32) % INTERN_SHARD_COUNT];
+    }
+
+    /**
+     * HashString will return the same hash as HashAssetID using a loop
+     * instead of recursion for asset ID's only known at run time.
+     * @param[in] theAssetID null terminated asset ID to hash
+     * @return the 64 bit hash of theAssetID
+     */
+    Uint64 HashString(const char* theAssetID)
+    {
+      Uint64 anHash = HashAssetID("");
+      for(; 0 != *theAssetID; theAssetID++)
+      {
+        anHash = (anHash ^ (Uint8)*theAssetID) * 1099511628211ULL;
+      }
+      return anHash;
+    }
+  } // namespace
+
+  AssetKey::AssetKey() :
+    mHash(HashAssetID("")),
+    mAssetID(Intern(mHash, ""))
+  {
+  }
+
+  AssetKey::AssetKey(const typeAssetID& theAssetID) :
+    mHash(HashString(theAssetID.c_str())),
+    mAssetID(Intern(mHash, theAssetID.c_str()))
+  {
+  }
+
+  AssetKey::AssetKey(const char* theAssetID) :
+    mHash(HashString(theAssetID)),
+    mAssetID(Intern(mHash, theAssetID))
+  {
+  }
+
+  AssetKey::AssetKey(Uint64 theHash) :
+    mHash(theHash),
+    mAssetID(NULL)
+  {
+    // Find the asset ID previously interned under theHash
+    {
+      typeInternShard& anShard = GetInternShard(theHash);
+      std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+      std::unordered_map<Uint64, typeAssetID>::const_iterator iter;
+      iter = anShard.strings.find(theHash);
+      if(iter != anShard.strings.end())
+      {
+        mAssetID = &iter->second;
+      }
+    }
+
+    // Never interned? fall back to the empty asset ID
+    if(NULL == mAssetID)
+    {
+      WLOG() << "AssetKey::ctor(" << theHash << ") Asset ID hash not found!"
+        << std::endl;
+      mHash = HashAssetID("");
+      mAssetID = Intern(mHash, "");
+    }
+  }
+
+  const typeAssetID* AssetKey::Intern(Uint64& theHash, const char* theAssetID)
+  {
+    while(true)
+    {
+      // Find and lock the shard that holds theHash
+      typeInternShard& anShard = GetInternShard(theHash);
+      std::lock_guard<std::mutex> anLock(anShard.mutex);
+
+      // Add theAssetID if this is the first time it has been seen
+      std::pair<std::unordered_map<Uint64, typeAssetID>::iterator, bool> anInsert =
+        anShard.strings.insert(std::make_pair(theHash, typeAssetID()));
+      if(anInsert.second)
+      {
+        anInsert.first->second = theAssetID;
+      }
+
+      // Return the interned copy if it is ours
+      if(anInsert.first->second == theAssetID)
+      {
+        return &anInsert.first->second;
+      }
+
+      // Two different asset ID's with the same hash, move on to the next
+      // hash in the sequence every key for theAssetID follows
+      const Uint64 anHash = theHash;
+      theHash = (theHash ^ 0x9e3779b97f4a7c15ULL) * 1099511628211ULL;
+      ELOG() << "AssetKey::Intern(" << theAssetID << ") hash " << anHash
+        << " collision with (" << anInsert.first->second << "), using hash "
+        << theHash << "!" << std::endl;
+    }
+  }
+
+  Uint64 HashAssetData(const void* theData, Uint64 theSize)
+  {
+    // MurmurHash64A by Austin Appleby (public domain)
+    const Uint64 anMultiply = 0xc6a4a7935bd1e995ULL;
+    const int anShift = 47;
+    const Uint8* anData = static_cast<const Uint8*>(theData);
+    Uint64 anHash = 0x9747b28c9747b28cULL ^ (theSize * anMultiply);
+
+    // Mix in 8 bytes at a time, memcpy allows any alignment
+    const Uint8* anEnd = anData + (theSize & ~(Uint64)7);
+    for(; anData != anEnd; anData += 8)
+    {
+      Uint64 anWord;
+      std::memcpy(&anWord, anData, sizeof(anWord));
+      anWord *= anMultiply;
+      anWord ^= anWord >> anShift;
+      anWord *= anMultiply;
+      anHash ^= anWord;
+      anHash *= anMultiply;
+    }
+
+    // Mix in the remaining 0 to 7 bytes
+    const Uint32 anRemaining = (Uint32)(theSize & 7);
+    if(0 != anRemaining)
+    {
+      for(Uint32 anIndex = anRemaining; anIndex > 0; anIndex--)
+      {
+        anHash ^= (Uint64)anData[anIndex - 1] << (8 * (anIndex - 1));
+      }
+      anHash *= anMultiply;
+    }
+
+    // Spread the last bits mixed in over the whole hash
+    anHash ^= anHash >> anShift;
+    anHash *= anMultiply;
+    anHash ^= anHash >> anShift;
+    return anHash;
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,209 @@
+/**
+* Provides the AssetLoader class in the GExL namespace which is responsible
+* for running asset loading tasks on a pool of background threads.
+*
+* @file src/GExL/assets/AssetLoader.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <GExL/assets/AssetLoader.hpp>
+#include <GExL/assets/AssetTrace.hpp>
+#include <GExL/logger/Log_macros.hpp>
+
+namespace GExL
+{
+  AssetLoader::AssetLoader() :
+    mBusy(0),
+    mRunning(false)
+  {
+    ILOGM("AssetLoader::ctor()");
+  }
+
+  AssetLoader::~AssetLoader()
+  {
+    ILOGM("AssetLoader::dtor()");
+
+    // Finish all queued tasks and join the loader threads
+    Stop();
+  }
+
+  void AssetLoader::Start(Uint32 theThreadCount)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+
+    // Only start the loader threads once
+    if(false == mRunning)
+    {
+      // Pick one thread per spare CPU core if no count was provided
+      if(0 == theThreadCount)
+      {
+        theThreadCount = std::thread::hardware_concurrency();
+        theThreadCount = (theThreadCount > 1) ? theThreadCount - 1 : 1;
+      }
+
+      ILOG() << "AssetLoader::Start(" << theThreadCount << ")" << std::endl;
+
+      // Start each loader thread now
+      mRunning = true;
+      for(Uint32 anIndex = 0; anIndex < theThreadCount; anIndex++)
+      {
+        mThreads.push_back(std::thread(&AssetLoader::Run, this));
+      }
+    }
+  }
+
+  void AssetLoader::Stop(void)
+  {
+    // Tell each loader thread to exit once the queue is empty
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      mRunning = false;
+    }
+    mTaskCondition.notify_all();
+
+    // Wait for each loader thread to exit
+    for(size_t anIndex = 0; anIndex < mThreads.size(); anIndex++)
+    {
+      mThreads[anIndex].join();
+    }
+    mThreads.clear();
+
+    // Run anything that was queued after the threads exited on this thread
+    std::unique_lock<std::mutex> anLock(mMutex);
+    typeLoadTask anTask;
+    while(PopTask(anTask))
+    {
+      anLock.unlock();
+      anTask();
+      anLock.lock();
+    }
+    mIdleCondition.notify_all();
+  }
+
+  bool AssetLoader::IsRunning(void) const
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return mRunning;
+  }
+
+  Uint32 AssetLoader::GetThreadCount(void) const
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    return (Uint32)mThreads.size();
+  }
+
+  void AssetLoader::AddTask(typeLoadTask theTask, AssetLoadPriority thePriority)
+  {
+    // Make sure someone will be around to run theTask
+    if(false == IsRunning())
+    {
+      Start();
+    }
+
+    // Queue theTask and wake up one of the loader threads
+    {
+      std::lock_guard<std::mutex> anLock(mMutex);
+      const Uint32 anPriority = (thePriority < AssetLoadPrefetch ||
+        thePriority > AssetLoadCritical) ? AssetLoadVisible : thePriority;
+      mTasks[anPriority].push_back(theTask);
+    }
+    mTaskCondition.notify_one();
+  }
+
+  void AssetLoader::WaitForIdle(void)
+  {
+    std::unique_lock<std::mutex> anLock(mMutex);
+    while(false == IsEmpty() || 0 != mBusy)
+    {
+      mIdleCondition.wait(anLock);
+    }
+  }
+
+  bool AssetLoader::PopTask(typeLoadTask& theTask)
+  {
+    // Look at the highest priority queue first
+    for(Uint32 anPriority = PRIORITY_COUNT; anPriority > 0; anPriority--)
+    {
+      std::deque<typeLoadTask>& anTasks = mTasks[anPriority - 1];
+      if(false == anTasks.empty())
+      {
+        theTask = anTasks.front();
+        anTasks.pop_front();
+        return true;
+      }
+    }
+
+    // Return false, there are no tasks waiting
+    return false;
+  }
+
+  bool AssetLoader::IsEmpty(void) const
+  {
+    for(Uint32 anPriority = 0; anPriority < PRIORITY_COUNT; anPriority++)
+    {
+      if(false == mTasks[anPriority].empty())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void AssetLoader::Run(void)
+  {
+    // Tell the loader threads apart from the rest in AssetTrace files
+    AssetTrace::SetThreadName("AssetLoader");
+
+    std::unique_lock<std::mutex> anLock(mMutex);
+    while(true)
+    {
+      // Wait for a task or for Stop to be called
+      while(mRunning && IsEmpty())
+      {
+        mTaskCondition.wait(anLock);
+      }
+
+      // Exit once Stop was called and every task has been run
+      typeLoadTask anTask;
+      if(false == PopTask(anTask))
+      {
+        break;
+      }
+
+      // Run the next task without holding the lock
+      mBusy++;
+      anLock.unlock();
+      anTask();
+      anLock.lock();
+      mBusy--;
+
+      // Let WaitForIdle callers know when all the work is done
+      if(IsEmpty() && 0 == mBusy)
+      {
+        mIdleCondition.notify_all();
+      }
+    }
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
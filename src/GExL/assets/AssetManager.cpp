@@ -8,12 +8,153 @@
 * @date 20140912 - Initial Release
 */
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <set>
 #include <GExL/assets/AssetManager.hpp>
+#include <GExL/assets/AssetTrace.hpp>
 #include <GExL/logger/Log_macros.hpp>
+#include <GExL/utils/StringUtil.hpp>
+
+namespace
+{
+  /// Asset of a group waiting to be started by AssetManager::LoadGroup
+  struct typeGroupLoad {
+    GExL::IAssetHandler* handler;  ///< Handler holding the group reference
+    GExL::AssetKey       key;      ///< Key of the asset to load
+    GExL::Int32          priority; ///< Higher priority assets are started first
+    const GExL::Uint8*   location; ///< Address in a mounted pack or NULL
+    std::string          filename; ///< Filename when not found in a pack
+  };
+
+  /// Sort by priority first and then by where the asset bytes are stored
+  bool SortByLocation(const typeGroupLoad& theLeft, const typeGroupLoad& theRight)
+  {
+    if(theLeft.priority != theRight.priority)
+    {
+      return theLeft.priority > theRight.priority;
+    }
+    if(theLeft.location != theRight.location)
+    {
+      return std::less<const GExL::Uint8*>()(theLeft.location, theRight.location);
+    }
+    return theLeft.filename < theRight.filename;
+  }
+
+  /**
+   * GetLoadPriority will map thePriority of a manifest entry onto the load
+   * priority given to the loader threads, 0 is the default Visible priority.
+   * @param[in] thePriority of the manifest entry
+   * @return Prefetch below 0, Visible for 0 or Critical above 0
+   */
+  GExL::AssetLoadPriority GetLoadPriority(GExL::Int32 thePriority)
+  {
+    if(0 > thePriority)
+    {
+      return GExL::AssetLoadPrefetch;
+    }
+    else if(0 < thePriority)
+    {
+      return GExL::AssetLoadCritical;
+    }
+    return GExL::AssetLoadVisible;
+  }
+
+  /// Asset of the graph loaded by AssetManager::LoadGraph
+  struct typeGraphNode {
+    GExL::IAssetHandler* handler;    ///< Handler holding the asset
+    GExL::AssetKey       key;        ///< Key of the asset to load
+    GExL::Uint32         waiting;    ///< Dependencies that haven't finished loading
+    size_t               examined;   ///< Dependencies already added to the graph
+    bool                 started;    ///< Has the load of the asset been started?
+    bool                 done;       ///< Has the load of the asset finished?
+    std::vector<size_t>  dependents; ///< Nodes waiting for this asset to load
+  };
+
+  /// Map of each handler and asset hash to its node in the graph
+  typedef std::map<std::pair<const GExL::IAssetHandler*, GExL::Uint64>, size_t> typeGraphIndex;
+
+  /**
+   * AddGraphNode will return the index of the node for theAsset in theNodes,
+   * adding a new node for it if it isn't in the graph yet.
+   * @param[in] theNodes of the graph
+   * @param[in] theIndex of each node in theNodes
+   * @param[in] theAsset to find or add
+   * @param[out] theAdded set to true if a new node was added
+   * @return the index of the node for theAsset
+   */
+  size_t AddGraphNode(std::vector<typeGraphNode>& theNodes, typeGraphIndex& theIndex,
+    const GExL::IAssetHandler::typeAssetDependency& theAsset, bool& theAdded)
+  {
+    std::pair<typeGraphIndex::iterator, bool> anResult = theIndex.insert(
+      std::make_pair(std::make_pair(theAsset.handler, theAsset.key.GetHash()),
+      theNodes.size()));
+    theAdded = anResult.second;
+    if(theAdded)
+    {
+      typeGraphNode anNode;
+      anNode.handler = theAsset.handler;
+      anNode.key = theAsset.key;
+      anNode.waiting = 0;
+      anNode.examined = 0;
+      anNode.started = false;
+      anNode.done = false;
+      theNodes.push_back(anNode);
+    }
+    return anResult.first->second;
+  }
+
+  /**
+   * ExpandGraph is responsible for adding the dependencies of theNode that
+   * haven't been examined yet to the graph, and theirs, breadth first. A
+   * node waits for each dependency that hasn't finished loading unless the
+   * node itself has already finished.
+   * @param[in] theNodes of the graph
+   * @param[in] theIndex of each node in theNodes
+   * @param[in] theNode to start from
+   */
+  void ExpandGraph(std::vector<typeGraphNode>& theNodes, typeGraphIndex& theIndex,
+    size_t theNode)
+  {
+    std::vector<size_t> anVisit(1, theNode);
+    for(size_t anVisited = 0; anVisited < anVisit.size(); anVisited++)
+    {
+      const size_t anNode = anVisit[anVisited];
+      std::vector<GExL::IAssetHandler::typeAssetDependency> anDependencies;
+      theNodes[anNode].handler->GetDependencies(theNodes[anNode].key, anDependencies);
+
+      // Dependencies are only ever appended, skip the ones seen before
+      for(size_t anIndex = theNodes[anNode].examined;
+        anIndex < anDependencies.size(); anIndex++)
+      {
+        bool anAdded = false;
+        const size_t anDependency = AddGraphNode(theNodes, theIndex,
+          anDependencies[anIndex], anAdded);
+        if(false == theNodes[anNode].done && false == theNodes[anDependency].done)
+        {
+          theNodes[anDependency].dependents.push_back(anNode);
+          theNodes[anNode].waiting++;
+        }
+        if(anAdded)
+        {
+          anVisit.push_back(anDependency);
+        }
+      }
+      theNodes[anNode].examined = anDependencies.size();
+    }
+  }
+}
 
 namespace GExL
 {
-  AssetManager::AssetManager()
+  AssetManager::AssetManager() :
+    mMemoryBudget(0),
+    mReleaseBudget(RELEASE_BUDGET),
+    mFinalizeThread(std::this_thread::get_id())
   {
     ILOGM("AssetManager::ctor()");
   }
@@ -22,9 +163,27 @@ namespace GExL
   {
     ILOGM("AssetManager::dtor()");
 
-    // Iterator to use while deleting all assets
+    // Stop watching for changes and finish any loads in flight before the
+    // handlers are deleted
+    mWatcher.Stop();
+    mLoader.Stop();
+
+    // Iterator to use while swapping in the last reloads and deleting all assets
     std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
 
+    // Give back the references held by loads and reloads that completed
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      iter->second->FinalizeLoads();
+      iter->second->FinishReloads();
+    }
+
+    // Drop the references between assets while every handler still exists
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      iter->second->ClearDependencies();
+    }
+
     // Loop through each asset handler and remove each one
     iter = mHandlers.begin();
     while(iter != mHandlers.end())
@@ -37,6 +196,16 @@ namespace GExL
       // Delete the Asset Handler
       delete anAssetHandler;
     }
+
+    // The flat type index array only held copies of the pointers deleted above
+    mTypeHandlers.clear();
+
+    // Unmap each asset pack now that no handler can load from them
+    for(size_t anIndex = 0; anIndex < mPacks.size(); anIndex++)
+    {
+      delete mPacks[anIndex];
+    }
+    mPacks.clear();
   }
 
   IAssetHandler& AssetManager::GetHandler(const typeAssetHandlerID theAssetHandlerID) const
@@ -68,6 +237,13 @@ namespace GExL
     return *anResult;
   }
 
+  IAssetHandler* AssetManager::FindHandler(const typeAssetHandlerID theAssetHandlerID) const
+  {
+    std::map<const typeAssetHandlerID, IAssetHandler*>::const_iterator iter =
+      mHandlers.find(theAssetHandlerID);
+    return (iter != mHandlers.end()) ? iter->second : NULL;
+  }
+
   void AssetManager::RegisterHandler(IAssetHandler* theAssetHandler)
   {
     // Iterator to the asset if found
@@ -86,6 +262,20 @@ namespace GExL
         mHandlers.insert(
           std::pair<const typeAssetHandlerID, IAssetHandler*>(
           theAssetHandler->GetID(), theAssetHandler));
+
+        // Let the handler know who to ask for loader threads
+        theAssetHandler->mAssetManager = this;
+
+        // Index the handler by the type index of the asset TYPE it manages
+        const Uint32 anTypeIndex = theAssetHandler->GetTypeIndex();
+        if(IAssetHandler::NO_TYPE_INDEX != anTypeIndex)
+        {
+          if(anTypeIndex >= mTypeHandlers.size())
+          {
+            mTypeHandlers.resize(anTypeIndex + 1, NULL);
+          }
+          mTypeHandlers[anTypeIndex] = theAssetHandler;
+        }
       }
       else
       {
@@ -103,14 +293,62 @@ namespace GExL
     }
   }
 
-  bool AssetManager::LoadAllAssets(void)
+  bool AssetManager::LoadAllAssets(bool theParallel)
   {
+    // Show the whole batch on the timeline of this thread
+    AssetTrace::Scope anTrace("LoadAllAssets", "AssetManager");
+
     // Return true if all assets load successfully
     bool anResult = true;
     
     // Iterator for each IAssetHandler registered
     std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
 
+    // Spread the loads of every handler over the loader threads
+    if(theParallel)
+    {
+      // Note the load time already spent so only our loads are measured
+      const std::chrono::steady_clock::time_point anStart =
+        std::chrono::steady_clock::now();
+      Uint64 anLoadTime = 0;
+      for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+      {
+        anLoadTime -= iter->second->GetLoadNanoseconds();
+      }
+
+      // Load every unloaded asset with its dependencies loaded first
+      std::vector<IAssetHandler::typeAssetDependency> anAssets;
+      for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+      {
+        std::vector<AssetKey> anUnloaded;
+        iter->second->GetUnloadedAssets(anUnloaded);
+        for(size_t anIndex = 0; anIndex < anUnloaded.size(); anIndex++)
+        {
+          IAssetHandler::typeAssetDependency anAsset;
+          anAsset.handler = iter->second;
+          anAsset.key = anUnloaded[anIndex];
+          anAssets.push_back(anAsset);
+        }
+      }
+      anResult = LoadGraph(anAssets);
+
+      // Report how much faster this was than loading each asset in turn
+      for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+      {
+        anLoadTime += iter->second->GetLoadNanoseconds();
+      }
+      const double anElapsed = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - anStart).count();
+      ILOG() << "AssetManager::LoadAllAssets() loaded " << anAssets.size()
+        << " assets in " << anElapsed / 1000000.0 << "ms on "
+        << mLoader.GetThreadCount() << " threads, " << anLoadTime / 1000000.0
+        << "ms of loading, speedup " << (anElapsed > 0.0 ? anLoadTime / anElapsed : 1.0)
+        << "x" << std::endl;
+
+      // Return anResult which is true if every load succeeded
+      return anResult;
+    }
+
     // Loop through each asset handler and tell it to load its assets
     iter = mHandlers.begin();
     while(iter != mHandlers.end())
@@ -127,6 +365,484 @@ namespace GExL
     return anResult;
   }
 
+  bool AssetManager::LoadGraph(const std::vector<IAssetHandler::typeAssetDependency>& theAssets)
+  {
+    // Show the whole batch on the timeline of this thread
+    AssetTrace::Scope anTrace("LoadGraph", "AssetManager");
+
+    // Return true if every asset was loaded
+    bool anResult = true;
+
+    // Every asset of the graph with the dependencies of theAssets added
+    std::vector<typeGraphNode> anNodes;
+    typeGraphIndex anIndex;
+    for(size_t anAsset = 0; anAsset < theAssets.size(); anAsset++)
+    {
+      bool anAdded = false;
+      const size_t anNode = AddGraphNode(anNodes, anIndex, theAssets[anAsset], anAdded);
+      if(anAdded)
+      {
+        ExpandGraph(anNodes, anIndex, anNode);
+      }
+    }
+
+    // Nodes whose load finished and their result, filled by the loader threads
+    std::mutex anMutex;
+    std::condition_variable anCondition;
+    std::vector<std::pair<size_t, bool> > anFinished;
+
+    // Number of loads started that haven't finished yet
+    size_t anInFlight = 0;
+
+    // Handlers of the graph to finalize loads for while waiting
+    std::set<IAssetHandler*> anHandlers;
+    const bool anFinalizes = IsFinalizeThread();
+
+    // Nodes that aren't waiting for a dependency, ready to be started
+    std::vector<size_t> anReady;
+    for(size_t anNode = 0; anNode < anNodes.size(); anNode++)
+    {
+      if(0 == anNodes[anNode].waiting)
+      {
+        anReady.push_back(anNode);
+      }
+    }
+
+    // Keep going until every node has been loaded
+    size_t anStarted = 0;
+    while(anStarted < anNodes.size() || 0 != anInFlight)
+    {
+      // Nothing ready and nothing in flight? then break the cycle left
+      if(anReady.empty() && 0 == anInFlight)
+      {
+        for(size_t anNode = 0; anNode < anNodes.size(); anNode++)
+        {
+          if(false == anNodes[anNode].started)
+          {
+            WLOG() << "AssetManager::LoadGraph(" << anNodes[anNode].key
+              << ") dependency cycle, loading it anyway" << std::endl;
+            anReady.push_back(anNode);
+            break;
+          }
+        }
+      }
+
+      // Start every node that is ready
+      for(size_t anReadyIndex = 0; anReadyIndex < anReady.size(); anReadyIndex++)
+      {
+        const size_t anNode = anReady[anReadyIndex];
+        anNodes[anNode].started = true;
+        anStarted++;
+        anInFlight++;
+        anHandlers.insert(anNodes[anNode].handler);
+
+        // The callback may be called right away on this thread
+        anNodes[anNode].handler->LoadAssetAsync(anNodes[anNode].key,
+          [&anMutex, &anCondition, &anFinished, anNode](const typeAssetID, bool theLoaded)
+          {
+            std::lock_guard<std::mutex> anLock(anMutex);
+            anFinished.push_back(std::make_pair(anNode, theLoaded));
+            anCondition.notify_one();
+          });
+      }
+      anReady.clear();
+
+      // Wait for the next loads to finish, finalizing loads meanwhile if
+      // this thread finalizes them (see IsFinalizeThread)
+      std::vector<std::pair<size_t, bool> > anDone;
+      while(anDone.empty() && 0 != anInFlight)
+      {
+        {
+          std::unique_lock<std::mutex> anLock(anMutex);
+          if(anFinished.empty() && anFinalizes)
+          {
+            anCondition.wait_for(anLock, std::chrono::milliseconds(1));
+          }
+          else if(anFinished.empty())
+          {
+            anCondition.wait(anLock);
+          }
+          anDone.swap(anFinished);
+        }
+        if(anDone.empty() && anFinalizes)
+        {
+          std::set<IAssetHandler*>::iterator iter;
+          for(iter = anHandlers.begin(); iter != anHandlers.end(); iter++)
+          {
+            (*iter)->FinalizeLoads();
+          }
+        }
+      }
+
+      // Let the nodes depending on each finished node go next
+      for(size_t anDoneIndex = 0; anDoneIndex < anDone.size(); anDoneIndex++)
+      {
+        const size_t anNode = anDone[anDoneIndex].first;
+        anResult &= anDone[anDoneIndex].second;
+        anInFlight--;
+        anNodes[anNode].done = true;
+        for(size_t anDependent = 0; anDependent < anNodes[anNode].dependents.size();
+          anDependent++)
+        {
+          const size_t anWaiting = anNodes[anNode].dependents[anDependent];
+          if(0 == --anNodes[anWaiting].waiting && false == anNodes[anWaiting].started)
+          {
+            anReady.push_back(anWaiting);
+          }
+        }
+
+        // Add the dependencies found while the node was loading
+        const size_t anCount = anNodes.size();
+        ExpandGraph(anNodes, anIndex, anNode);
+        for(size_t anAdded = anCount; anAdded < anNodes.size(); anAdded++)
+        {
+          if(0 == anNodes[anAdded].waiting)
+          {
+            anReady.push_back(anAdded);
+          }
+        }
+      }
+    }
+
+    ILOG() << "AssetManager::LoadGraph() loaded " << anNodes.size()
+      << " assets" << std::endl;
+
+    // Return anResult which is true if every load succeeded
+    return anResult;
+  }
+
+  Uint32 AssetManager::LoadPendingAssets(Uint32 theBudget)
+  {
+    // Number of assets still waiting to be loaded
+    Uint32 anResult = 0;
+
+    // Stop starting new loads once the budget has been spent
+    const std::chrono::steady_clock::time_point anDeadline =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(theBudget);
+
+    // Give each handler whatever time is left, the rest just count
+    std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      anResult += iter->second->LoadPendingAssets(anDeadline);
+    }
+
+    // Return the number of assets that are still waiting
+    return anResult;
+  }
+
+  Uint32 AssetManager::ReleaseDeferredAssets(Uint32 theBudget)
+  {
+    // Number of assets still waiting to be released
+    Uint32 anResult = 0;
+
+    // Stop starting new releases once the budget has been spent
+    const std::chrono::steady_clock::time_point anDeadline =
+      std::chrono::steady_clock::now() + std::chrono::microseconds(theBudget);
+
+    // Give each handler whatever time is left, the rest just count
+    std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      anResult += iter->second->ReleaseDeferredAssets(anDeadline);
+    }
+
+    // Return the number of assets that are still waiting
+    return anResult;
+  }
+
+  void AssetManager::SetReleaseBudget(Uint32 theBudget)
+  {
+    mReleaseBudget = theBudget;
+  }
+
+  Uint32 AssetManager::GetReleaseBudget(void) const
+  {
+    return mReleaseBudget;
+  }
+
+  bool AssetManager::LoadGroup(const std::vector<AssetGroup::typeManifestEntry>& theManifest,
+    AssetGroup& theGroup, AssetLoadStyle theLoadStyle, AssetDropTime theDropTime)
+  {
+    // Show the whole batch on the timeline of this thread
+    AssetTrace::Scope anTrace("LoadGroup", "AssetManager");
+
+    // Return true if every asset was acquired
+    bool anResult = true;
+
+    // Give back whatever the group held before
+    theGroup.Release();
+
+    // Acquire every asset and note where its bytes are stored
+    std::vector<typeGroupLoad> anLoads;
+    anLoads.reserve(theManifest.size());
+    for(size_t anIndex = 0; anIndex < theManifest.size(); anIndex++)
+    {
+      const AssetGroup::typeManifestEntry& anEntry = theManifest[anIndex];
+
+      std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter =
+        mHandlers.find(anEntry.handlerID);
+      if(iter == mHandlers.end())
+      {
+        ELOG() << "AssetManager::LoadGroup(" << anEntry.assetID << ") handler "
+          << anEntry.handlerID << " not found!" << std::endl;
+        anResult = false;
+        continue;
+      }
+
+      typeGroupLoad anLoad;
+      anLoad.handler = iter->second;
+      anLoad.key = AssetKey(anEntry.assetID);
+      anLoad.priority = anEntry.priority;
+      anLoad.location = NULL;
+      if(false == anLoad.handler->AddReference(anLoad.key, theLoadStyle, theDropTime,
+        GetLoadPriority(anLoad.priority)))
+      {
+        anResult = false;
+        continue;
+      }
+
+      // Assets found in a mounted pack are ordered by their pack offset
+      anLoad.location = LocatePackData(anLoad.key);
+      if(NULL == anLoad.location)
+      {
+        anLoad.filename = anLoad.handler->GetFilename(anLoad.key);
+      }
+      anLoads.push_back(anLoad);
+    }
+
+    // Start the loads highest priority first, then in storage order
+    std::stable_sort(anLoads.begin(), anLoads.end(), SortByLocation);
+    theGroup.mAssets.reserve(anLoads.size());
+    for(size_t anIndex = 0; anIndex < anLoads.size(); anIndex++)
+    {
+      AssetGroup::typeGroupAsset anAsset;
+      anAsset.handler = anLoads[anIndex].handler;
+      anAsset.key = anLoads[anIndex].key;
+      anAsset.dropTime = theDropTime;
+      anAsset.future = anAsset.handler->LoadAssetAsync(anAsset.key);
+      theGroup.mAssets.push_back(anAsset);
+    }
+
+    ILOG() << "AssetManager::LoadGroup() started " << anLoads.size()
+      << " of " << theManifest.size() << " assets" << std::endl;
+
+    // Return anResult which is true if every asset was acquired
+    return anResult;
+  }
+
+  AssetLoader& AssetManager::GetLoader(void)
+  {
+    return mLoader;
+  }
+
+  bool AssetManager::IsFinalizeThread(void) const
+  {
+    return std::this_thread::get_id() == mFinalizeThread;
+  }
+
+  void AssetManager::SetMemoryBudget(Uint64 theBytes)
+  {
+    mMemoryBudget = theBytes;
+
+    // Trim right away in case we are already over the new budget
+    CheckMemoryBudget();
+  }
+
+  Uint64 AssetManager::GetMemoryBudget(void) const
+  {
+    return mMemoryBudget;
+  }
+
+  Uint64 AssetManager::GetResidentBytes(void) const
+  {
+    // Total number of bytes resident for every handler
+    Uint64 anResult = 0;
+
+    // Iterator for each IAssetHandler registered
+    std::map<const typeAssetHandlerID, IAssetHandler*>::const_iterator iter;
+
+    // Loop through each asset handler and add up its resident bytes
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      anResult += iter->second->GetResidentBytes();
+    }
+
+    // Return the total number of resident bytes
+    return anResult;
+  }
+
+  void AssetManager::CheckMemoryBudget(void)
+  {
+    // Nothing to do if there is no global budget or we are within it
+    const Uint64 anBudget = mMemoryBudget;
+    const Uint64 anResident = (0 != anBudget) ? GetResidentBytes() : 0;
+    if(anResident <= anBudget)
+    {
+      return;
+    }
+
+    // Number of bytes that still need to be freed
+    Uint64 anExcess = anResident - anBudget;
+
+    // Iterator for each IAssetHandler registered
+    std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
+
+    // Ask each asset handler in turn to release its unused assets
+    for(iter = mHandlers.begin(); iter != mHandlers.end() && 0 != anExcess; iter++)
+    {
+      Uint64 anFreed = iter->second->TrimCache(anExcess);
+      anExcess = (anFreed < anExcess) ? anExcess - anFreed : 0;
+    }
+  }
+
+  void AssetManager::WriteStats(std::ostream& theStream) const
+  {
+    theStream << "{\n  \"memoryBudget\": " << mMemoryBudget
+      << ",\n  \"residentBytes\": " << GetResidentBytes()
+      << ",\n  \"handlers\": [";
+
+    // Write one object for each handler
+    std::map<const typeAssetHandlerID, IAssetHandler*>::const_iterator iter;
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      IAssetHandler::typeAssetStats anStats;
+      iter->second->GetStats(anStats);
+
+      theStream << (iter == mHandlers.begin() ? "\n" : ",\n") << "    {\"id\": "
+        << StringToJSON(iter->first)
+        << ",\n      \"assets\": " << anStats.assets
+        << ",\n      \"assetsMaximum\": " << anStats.assetsMaximum
+        << ",\n      \"loadedAssets\": " << anStats.loadedAssets
+        << ",\n      \"deferredAssets\": " << anStats.deferredAssets
+        << ",\n      \"residentBytes\": " << anStats.residentBytes
+        << ",\n      \"residentBytesMaximum\": " << anStats.residentBytesMaximum
+        << ",\n      \"memoryBudget\": " << anStats.memoryBudget
+        << ",\n      \"referenceHits\": " << anStats.referenceHits
+        << ",\n      \"referenceCreates\": " << anStats.referenceCreates
+        << ",\n      \"loads\": " << anStats.loads
+        << ",\n      \"loadFailures\": " << anStats.loadFailures
+        << ",\n      \"coalescedLoads\": " << anStats.coalescedLoads
+        << ",\n      \"sharedLoads\": " << anStats.sharedLoads
+        << ",\n      \"loadNanoseconds\": " << anStats.loadNanoseconds
+        << ",\n      \"loadNanosecondsMaximum\": " << anStats.loadNanosecondsMaximum
+        << ",\n      \"loadTimes\": [";
+      for(Uint32 anIndex = 0; anIndex < IAssetHandler::LOAD_TIME_BUCKETS; anIndex++)
+      {
+        theStream << (0 == anIndex ? "" : ", ") << anStats.loadTimes[anIndex];
+      }
+      theStream << "]}";
+    }
+    theStream << "\n  ]\n}\n";
+  }
+
+  bool AssetManager::MountPack(const std::string& theFilename)
+  {
+    // Map the pack file and keep it if its table of contents is valid
+    AssetPack* anPack = new(std::nothrow) AssetPack();
+    if(NULL == anPack || false == anPack->Open(theFilename))
+    {
+      ELOG() << "AssetManager::MountPack(" << theFilename
+        << ") unable to mount pack!" << std::endl;
+      delete anPack;
+      return false;
+    }
+    mPacks.push_back(anPack);
+
+    ILOG() << "AssetManager::MountPack(" << theFilename << ") mounted "
+      << anPack->GetCount() << " assets" << std::endl;
+
+    // Return true, the pack is now searched by FindPackData
+    return true;
+  }
+
+  bool AssetManager::FindPackData(const AssetKey& theAssetID, AssetSpan& theSpan,
+    std::vector<Uint8>& theBuffer) const
+  {
+    // Search the newest pack first so later packs can override earlier ones
+    for(size_t anIndex = mPacks.size(); anIndex > 0; anIndex--)
+    {
+      if(mPacks[anIndex - 1]->Find(theAssetID, theSpan, theBuffer))
+      {
+        return true;
+      }
+    }
+
+    // Return false, theAssetID is not in any mounted pack
+    return false;
+  }
+
+  const Uint8* AssetManager::LocatePackData(const AssetKey& theAssetID) const
+  {
+    // Search the newest pack first, the same order FindPackData uses
+    for(size_t anIndex = mPacks.size(); anIndex > 0; anIndex--)
+    {
+      const Uint8* anResult = mPacks[anIndex - 1]->Locate(theAssetID);
+      if(NULL != anResult)
+      {
+        return anResult;
+      }
+    }
+
+    // Return NULL, theAssetID is not in any mounted pack
+    return NULL;
+  }
+
+  bool AssetManager::WatchDirectory(const std::string& theDirectory)
+  {
+    return mWatcher.Watch(theDirectory);
+  }
+
+  Uint32 AssetManager::ReloadFile(const std::string& theFilename)
+  {
+    // Number of assets affected by every handler
+    Uint32 anResult = 0;
+
+    // Iterator for each IAssetHandler registered
+    std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
+
+    // Any handler might have loaded an asset from theFilename
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      anResult += iter->second->ReloadFile(theFilename);
+    }
+
+    if(0 == anResult)
+    {
+      ILOG() << "AssetManager::ReloadFile(" << theFilename
+        << ") no assets loaded from this file" << std::endl;
+    }
+
+    // Return the number of assets affected
+    return anResult;
+  }
+
+  void AssetManager::Update(void)
+  {
+    // Finish the assets loaded and reloaded since the last update
+    std::map<const typeAssetHandlerID, IAssetHandler*>::iterator iter;
+    for(iter = mHandlers.begin(); iter != mHandlers.end(); iter++)
+    {
+      iter->second->FinalizeLoads();
+      iter->second->FinishReloads();
+    }
+
+    // Release the unused assets dropped since the last update
+    const Uint32 anBudget = mReleaseBudget;
+    if(0 != anBudget)
+    {
+      ReleaseDeferredAssets(anBudget);
+    }
+
+    // Start reloading the assets of every file that changed
+    std::vector<std::string> anChanges;
+    mWatcher.GetChanges(anChanges);
+    for(size_t anIndex = 0; anIndex < anChanges.size(); anIndex++)
+    {
+      ReloadFile(anChanges[anIndex]);
+    }
+  }
+
 } // namespace GExL
 
 /**
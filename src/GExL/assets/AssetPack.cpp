@@ -0,0 +1,541 @@
+/**
+* Provides the AssetPack class in the GExL namespace which is responsible
+* for memory mapping a GExL asset pack file and finding the data of each
+* asset stored in it.
+*
+* @file src/GExL/assets/AssetPack.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <cstring>
+#include <new>
+#include <GExL/assets/AssetPack.hpp>
+#include <GExL/logger/Log_macros.hpp>
+#if defined(GExL_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GExL
+{
+  namespace
+  {
+    /**
+     * FromLittle32 will convert theValue stored in little endian byte order
+     * to the byte order of this machine.
+     * @param[in] theValue read from the pack file
+     * @return theValue in the byte order of this machine
+     */
+    Uint32 FromLittle32(Uint32 theValue)
+    {
+#if defined(GExL_ENDIAN_BIG)
+      return ((theValue & 0x000000FFU) << 24) | ((theValue & 0x0000FF00U) << 8) |
+        ((theValue & 0x00FF0000U) >> 8) | ((theValue & 0xFF000000U) >> 24);
+#else
+      return theValue;
+#endif
+    }
+
+    /**
+     * FromLittle64 will convert theValue stored in little endian byte order
+     * to the byte order of this machine.
+     * @param[in] theValue read from the pack file
+     * @return theValue in the byte order of this machine
+     */
+    Uint64 FromLittle64(Uint64 theValue)
+    {
+#if defined(GExL_ENDIAN_BIG)
+      return ((Uint64)FromLittle32((Uint32)theValue) << 32) |
+        FromLittle32((Uint32)(theValue >> 32));
+#else
+      return theValue;
+#endif
+    }
+
+    /// Minimum number of bytes Compress will encode as a match
+    const Uint64 MIN_MATCH = 4;
+    /// Largest distance back Compress will look for a match
+    const Uint64 MAX_OFFSET = 65535;
+    /// Number of bits used to index the Compress match table
+    const Uint32 MATCH_TABLE_BITS = 14;
+
+    /**
+     * Read32 will return the 4 bytes found at theData in a form that can be
+     * compared and hashed, the byte order doesn't matter.
+     * @param[in] theData to read 4 bytes from
+     * @return the 4 bytes found at theData
+     */
+    Uint32 Read32(const Uint8* theData)
+    {
+      Uint32 anResult;
+      memcpy(&anResult, theData, sizeof(anResult));
+      return anResult;
+    }
+
+    /**
+     * WriteLength will append the remainder of a literal or match length
+     * that did not fit in the 4 bits of the sequence token.
+     * @param[in] theLength remaining after the token (already minus 15)
+     * @param[out] theResult to append the length bytes to
+     */
+    void WriteLength(Uint64 theLength, std::vector<Uint8>& theResult)
+    {
+      while(theLength >= 255)
+      {
+        theResult.push_back(255);
+        theLength -= 255;
+      }
+      theResult.push_back((Uint8)theLength);
+    }
+
+    /**
+     * ReadLength will add the remainder of a literal or match length that
+     * did not fit in the 4 bits of the sequence token to theLength.
+     * @param[in,out] theData position to read from, moved past the length
+     * @param[in] theEnd of the compressed data
+     * @param[in,out] theLength to add the remainder to
+     * @return true if the length was read, false if theEnd was reached first
+     */
+    bool ReadLength(const Uint8*& theData, const Uint8* theEnd, Uint64& theLength)
+    {
+      Uint8 anByte = 255;
+      while(255 == anByte)
+      {
+        if(theData == theEnd)
+        {
+          return false;
+        }
+        anByte = *theData++;
+        theLength += anByte;
+      }
+      return true;
+    }
+
+    /**
+     * WriteSequence will append a single sequence of theLiteralSize literal
+     * bytes followed by an optional match of theMatchSize bytes found
+     * theOffset bytes back.
+     * @param[in] theLiterals to copy into the sequence
+     * @param[in] theLiteralSize number of literal bytes
+     * @param[in] theOffset back to the start of the match
+     * @param[in] theMatchSize number of matching bytes or 0 for the last sequence
+     * @param[out] theResult to append the sequence to
+     */
+    void WriteSequence(const Uint8* theLiterals, Uint64 theLiteralSize,
+      Uint64 theOffset, Uint64 theMatchSize, std::vector<Uint8>& theResult)
+    {
+      // The token holds up to 15 for each length, the rest follows it
+      const Uint64 anMatchLength = (0 < theMatchSize) ? theMatchSize - MIN_MATCH : 0;
+      Uint8 anToken = (Uint8)(((theLiteralSize < 15 ? theLiteralSize : 15) << 4) |
+        (anMatchLength < 15 ? anMatchLength : 15));
+      theResult.push_back(anToken);
+      if(theLiteralSize >= 15)
+      {
+        WriteLength(theLiteralSize - 15, theResult);
+      }
+      theResult.insert(theResult.end(), theLiterals, theLiterals + theLiteralSize);
+
+      // The last sequence has no match
+      if(0 < theMatchSize)
+      {
+        theResult.push_back((Uint8)(theOffset & 0xFF));
+        theResult.push_back((Uint8)(theOffset >> 8));
+        if(anMatchLength >= 15)
+        {
+          WriteLength(anMatchLength - 15, theResult);
+        }
+      }
+    }
+  } // namespace
+
+  AssetPack::AssetPack() :
+    mData(NULL),
+    mSize(0),
+    mEntries(NULL),
+    mCount(0)
+#if defined(GExL_WINDOWS)
+    , mFile(INVALID_HANDLE_VALUE),
+    mMapping(NULL)
+#endif
+  {
+  }
+
+  AssetPack::~AssetPack()
+  {
+    Close();
+  }
+
+  bool AssetPack::Open(const std::string& theFilename)
+  {
+    // Only one pack file may be mapped at a time
+    Close();
+
+    ILOG() << "AssetPack::Open(" << theFilename << ")" << std::endl;
+
+#if defined(GExL_WINDOWS)
+    // Map the entire pack file read only
+    mFile = CreateFileA(theFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(INVALID_HANDLE_VALUE == mFile)
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") unable to open file!" << std::endl;
+      return false;
+    }
+    LARGE_INTEGER anFileSize;
+    if(FALSE == GetFileSizeEx(mFile, &anFileSize) || 0 == anFileSize.QuadPart)
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") empty pack file!" << std::endl;
+      Close();
+      return false;
+    }
+    mSize = (Uint64)anFileSize.QuadPart;
+    mMapping = CreateFileMappingA(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(NULL != mMapping)
+    {
+      mData = static_cast<const Uint8*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    // Map the entire pack file read only, the mapping outlives the descriptor
+    int anFile = open(theFilename.c_str(), O_RDONLY);
+    if(0 > anFile)
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") unable to open file!" << std::endl;
+      return false;
+    }
+    struct stat anStat;
+    if(0 != fstat(anFile, &anStat) || 0 == anStat.st_size)
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") empty pack file!" << std::endl;
+      close(anFile);
+      return false;
+    }
+    mSize = (Uint64)anStat.st_size;
+    void* anMapping = mmap(NULL, (size_t)mSize, PROT_READ, MAP_PRIVATE, anFile, 0);
+    close(anFile);
+    if(MAP_FAILED != anMapping)
+    {
+      mData = static_cast<const Uint8*>(anMapping);
+    }
+#endif
+    if(NULL == mData)
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") unable to map file!" << std::endl;
+      Close();
+      return false;
+    }
+    mFilename = theFilename;
+
+    // Check the header before trusting anything else in the file
+    typePackHeader anHeader;
+    if(mSize < sizeof(anHeader))
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") file too small!" << std::endl;
+      Close();
+      return false;
+    }
+    memcpy(&anHeader, mData, sizeof(anHeader));
+    if(0 != memcmp(anHeader.magic, "GEXLPACK", sizeof(anHeader.magic)) ||
+      PACK_VERSION != FromLittle32(anHeader.version))
+    {
+      ELOG() << "AssetPack::Open(" << theFilename << ") not a version "
+        << PACK_VERSION << " asset pack!" << std::endl;
+      Close();
+      return false;
+    }
+
+    // Make sure the table of contents fits inside the file
+    const Uint64 anCount = FromLittle32(anHeader.count);
+    const Uint64 anTocOffset = FromLittle64(anHeader.tocOffset);
+    if(0 != (anTocOffset % 8) || anTocOffset > mSize ||
+      anCount > (mSize - anTocOffset) / sizeof(typePackEntry))
+    {
+      ELOG() << "AssetPack::Open(" << theFilename
+        << ") invalid table of contents!" << std::endl;
+      Close();
+      return false;
+    }
+    mEntries = reinterpret_cast<const typePackEntry*>(mData + anTocOffset);
+    mCount = (Uint32)anCount;
+
+    // Make sure every asset blob fits inside the file and is stored in a
+    // way Find understands, raw blobs are handed out as they are stored and
+    // each compressed byte expands to at most 255 bytes (see Compress)
+    for(Uint32 anIndex = 0; anIndex < mCount; anIndex++)
+    {
+      typePackEntry anEntry = GetEntry(anIndex);
+      if(anEntry.offset > mSize || anEntry.storedSize > mSize - anEntry.offset ||
+        (0 != anEntry.flags && ENTRY_COMPRESSED != anEntry.flags) ||
+        (0 == anEntry.flags && anEntry.size != anEntry.storedSize) ||
+        (ENTRY_COMPRESSED == anEntry.flags &&
+          anEntry.size > anEntry.storedSize * 255 + 16) ||
+        (0 < anIndex && GetEntry(anIndex - 1).hash > anEntry.hash))
+      {
+        ELOG() << "AssetPack::Open(" << theFilename << ") invalid entry("
+          << anIndex << ")!" << std::endl;
+        Close();
+        return false;
+      }
+    }
+
+    // Return true, the pack is ready for Find
+    return true;
+  }
+
+  void AssetPack::Close(void)
+  {
+#if defined(GExL_WINDOWS)
+    if(NULL != mData)
+    {
+      UnmapViewOfFile(mData);
+    }
+    if(NULL != mMapping)
+    {
+      CloseHandle(mMapping);
+      mMapping = NULL;
+    }
+    if(INVALID_HANDLE_VALUE != mFile)
+    {
+      CloseHandle(mFile);
+      mFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if(NULL != mData)
+    {
+      munmap(const_cast<Uint8*>(mData), (size_t)mSize);
+    }
+#endif
+    mData = NULL;
+    mSize = 0;
+    mEntries = NULL;
+    mCount = 0;
+    mFilename.clear();
+  }
+
+  bool AssetPack::IsOpen(void) const
+  {
+    return NULL != mData;
+  }
+
+  const std::string& AssetPack::GetFilename(void) const
+  {
+    return mFilename;
+  }
+
+  Uint32 AssetPack::GetCount(void) const
+  {
+    return mCount;
+  }
+
+  bool AssetPack::Find(const AssetKey& theAssetID, AssetSpan& theSpan,
+    std::vector<Uint8>& theBuffer) const
+  {
+    typePackEntry anEntry;
+    if(false == FindEntry(theAssetID, anEntry))
+    {
+      return false;
+    }
+
+    // Hand out raw bytes straight from the mapping
+    if(0 == anEntry.flags)
+    {
+      theSpan = AssetSpan(mData + anEntry.offset, anEntry.size);
+      return true;
+    }
+
+    // Open only accepts ENTRY_COMPRESSED for the other entries and bounds
+    // their size, decompress them into the buffer owned by the caller
+    try
+    {
+      theBuffer.resize((size_t)anEntry.size);
+    }
+    catch(const std::bad_alloc&)
+    {
+      ELOG() << "AssetPack::Find(" << theAssetID << ") unable to allocate "
+        << anEntry.size << " bytes to decompress into!" << std::endl;
+      return false;
+    }
+    if(false == Decompress(mData + anEntry.offset, anEntry.storedSize,
+      theBuffer.empty() ? NULL : &theBuffer[0], anEntry.size))
+    {
+      ELOG() << "AssetPack::Find(" << theAssetID
+        << ") corrupt compressed data in " << mFilename << std::endl;
+      return false;
+    }
+    theSpan = AssetSpan(theBuffer.empty() ? NULL : &theBuffer[0], anEntry.size);
+    return true;
+  }
+
+  const Uint8* AssetPack::Locate(const AssetKey& theAssetID) const
+  {
+    typePackEntry anEntry;
+    if(false == FindEntry(theAssetID, anEntry))
+    {
+      return NULL;
+    }
+    return mData + anEntry.offset;
+  }
+
+  bool AssetPack::FindEntry(const AssetKey& theAssetID, typePackEntry& theEntry) const
+  {
+    // Binary search the table of contents which is sorted by hash
+    Uint32 anLow = 0;
+    Uint32 anHigh = mCount;
+    while(anLow < anHigh)
+    {
+      Uint32 anMiddle = anLow + (anHigh - anLow) / 2;
+      theEntry = GetEntry(anMiddle);
+      if(theEntry.hash < theAssetID.GetHash())
+      {
+        anLow = anMiddle + 1;
+      }
+      else if(theEntry.hash > theAssetID.GetHash())
+      {
+        anHigh = anMiddle;
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    // Return false, theAssetID is not in this pack
+    return false;
+  }
+
+  void AssetPack::Compress(const Uint8* theData, Uint64 theSize,
+    std::vector<Uint8>& theResult)
+  {
+    theResult.clear();
+    theResult.reserve((size_t)(theSize + theSize / 255 + 16));
+
+    // Table of the last position each 4 byte value was seen at, plus one
+    std::vector<Uint64> anTable((size_t)1 << MATCH_TABLE_BITS, 0);
+
+    // Greedily replace each repeated run of bytes with a match
+    Uint64 anAnchor = 0;
+    Uint64 anPosition = 0;
+    while(anPosition + MIN_MATCH <= theSize)
+    {
+      const Uint32 anValue = Read32(theData + anPosition);
+      const Uint32 anSlot = (anValue * 2654435761U) >> (32 - MATCH_TABLE_BITS);
+      const Uint64 anCandidate = anTable[anSlot];
+      anTable[anSlot] = anPosition + 1;
+      if(0 < anCandidate && anPosition - (anCandidate - 1) <= MAX_OFFSET &&
+        Read32(theData + anCandidate - 1) == anValue)
+      {
+        const Uint64 anMatch = anCandidate - 1;
+        Uint64 anLength = MIN_MATCH;
+        while(anPosition + anLength < theSize &&
+          theData[anMatch + anLength] == theData[anPosition + anLength])
+        {
+          anLength++;
+        }
+        WriteSequence(theData + anAnchor, anPosition - anAnchor,
+          anPosition - anMatch, anLength, theResult);
+        anPosition += anLength;
+        anAnchor = anPosition;
+      }
+      else
+      {
+        anPosition++;
+      }
+    }
+
+    // The last sequence holds the remaining literals
+    WriteSequence(theData + anAnchor, theSize - anAnchor, 0, 0, theResult);
+  }
+
+  bool AssetPack::Decompress(const Uint8* theData, Uint64 theSize,
+    Uint8* theResult, Uint64 theResultSize)
+  {
+    const Uint8* anEnd = theData + theSize;
+    Uint64 anPosition = 0;
+    while(theData < anEnd)
+    {
+      // Copy the literals that start each sequence
+      const Uint8 anToken = *theData++;
+      Uint64 anLiteralSize = anToken >> 4;
+      if(15 == anLiteralSize && false == ReadLength(theData, anEnd, anLiteralSize))
+      {
+        return false;
+      }
+      if(anLiteralSize > (Uint64)(anEnd - theData) ||
+        anLiteralSize > theResultSize - anPosition)
+      {
+        return false;
+      }
+      memcpy(theResult + anPosition, theData, (size_t)anLiteralSize);
+      theData += anLiteralSize;
+      anPosition += anLiteralSize;
+
+      // The last sequence has no match
+      if(theData == anEnd)
+      {
+        break;
+      }
+
+      // Copy the match one byte at a time since it may overlap itself
+      if(2 > anEnd - theData)
+      {
+        return false;
+      }
+      const Uint64 anOffset = (Uint64)theData[0] | ((Uint64)theData[1] << 8);
+      theData += 2;
+      Uint64 anMatchSize = anToken & 0x0F;
+      if(15 == anMatchSize && false == ReadLength(theData, anEnd, anMatchSize))
+      {
+        return false;
+      }
+      anMatchSize += MIN_MATCH;
+      if(0 == anOffset || anOffset > anPosition ||
+        anMatchSize > theResultSize - anPosition)
+      {
+        return false;
+      }
+      for(Uint64 anIndex = 0; anIndex < anMatchSize; anIndex++, anPosition++)
+      {
+        theResult[anPosition] = theResult[anPosition - anOffset];
+      }
+    }
+
+    // Return true if every byte expected was produced
+    return anPosition == theResultSize;
+  }
+
+  AssetPack::typePackEntry AssetPack::GetEntry(Uint32 theIndex) const
+  {
+    typePackEntry anResult = mEntries[theIndex];
+    anResult.hash = FromLittle64(anResult.hash);
+    anResult.offset = FromLittle64(anResult.offset);
+    anResult.storedSize = FromLittle64(anResult.storedSize);
+    anResult.size = FromLittle64(anResult.size);
+    anResult.flags = FromLittle32(anResult.flags);
+    return anResult;
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
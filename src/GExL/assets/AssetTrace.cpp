@@ -0,0 +1,362 @@
+/**
+* Provides the AssetTrace class in the GExL namespace which is responsible
+* for recording asset load timelines that can be viewed in chrome://tracing
+* or Perfetto.
+*
+* @file src/GExL/assets/AssetTrace.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include <GExL/assets/AssetTrace.hpp>
+#include <GExL/logger/Log_macros.hpp>
+#include <GExL/utils/StringUtil.hpp>
+
+namespace GExL
+{
+  namespace
+  {
+    /// Structure holding each event recorded
+    struct typeTraceEvent {
+      Uint64             time;     ///< Steady clock time in nanoseconds
+      const char*        name;     ///< Name of begin events
+      const char*        category; ///< Category of begin events
+      const typeAssetID* asset;    ///< Asset of begin events or NULL
+      char               phase;    ///< 'B' for begin or 'E' for end
+    };
+
+    /// Structure holding the events recorded by one thread
+    struct typeTraceBuffer {
+      Uint32                thread;   ///< Thread ID written to the trace
+      std::string           name;     ///< Name of the thread or empty
+      Uint32                capacity; ///< Number of events that fit
+      std::atomic<Uint32>   count;    ///< Number of events published
+      typeTraceEvent*       events;   ///< Events recorded by the thread
+    };
+
+    /// Structure holding the state shared by every thread
+    struct typeTraceState {
+      std::mutex                     mutex;      ///< Lock protecting the buffers
+      std::vector<typeTraceBuffer*>  buffers;    ///< Buffer of each thread
+      std::atomic<bool>              recording;  ///< True while recording
+      std::atomic<Uint32>            generation; ///< Changed by Start and Clear
+      std::atomic<Uint32>            writers;    ///< Threads writing an event
+      std::atomic<Uint64>            dropped;    ///< Begin events dropped
+      Uint32                         capacity;   ///< Events per new buffer
+      Uint64                         start;      ///< Time Start was called
+    };
+
+    /// Buffer the calling thread records into
+    thread_local typeTraceBuffer* tBuffer = NULL;
+    /// Generation tBuffer was created for, 0 if none
+    thread_local Uint32 tGeneration = 0;
+    /// Number of begin events recorded in tBuffer not yet ended
+    thread_local Uint32 tOpen = 0;
+    /// Name given by SetThreadName to the calling thread
+    thread_local std::string tName;
+
+    /**
+     * GetTraceState will return the state shared by every thread. It is
+     * never deleted so threads still running while the application exits
+     * can check it safely.
+     * @return the trace state
+     */
+    typeTraceState& GetTraceState(void)
+    {
+      static typeTraceState* sState = new typeTraceState();
+      return *sState;
+    }
+
+    /**
+     * GetTraceTime will return the current steady clock time in nanoseconds.
+     * @return the current time in nanoseconds
+     */
+    Uint64 GetTraceTime(void)
+    {
+      return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * DeleteBuffers is responsible for deleting the buffer of every thread.
+     * The generation is changed first so no thread starts writing to the
+     * buffers again, then the events still being written are waited for
+     * (see Record). The mutex of theState must be held by the caller.
+     * @param[in] theState holding the buffers to delete
+     */
+    void DeleteBuffers(typeTraceState& theState)
+    {
+      // Make every thread create a new buffer before recording again
+      theState.generation++;
+
+      // Wait for the threads that checked the generation before it changed
+      while(0 != theState.writers)
+      {
+        std::this_thread::yield();
+      }
+
+      for(size_t anIndex = 0; anIndex < theState.buffers.size(); anIndex++)
+      {
+        delete[] theState.buffers[anIndex]->events;
+        delete theState.buffers[anIndex];
+      }
+      theState.buffers.clear();
+    }
+
+    /**
+     * CreateBuffer is responsible for creating the buffer of the calling
+     * thread for the current generation, tBuffer is left NULL if out of
+     * memory. The calling thread must not be counted as a writer.
+     * @param[in] theState to register the new buffer with
+     */
+    void CreateBuffer(typeTraceState& theState)
+    {
+      std::lock_guard<std::mutex> anLock(theState.mutex);
+      tBuffer = NULL;
+      tGeneration = theState.generation;
+      tOpen = 0;
+
+      typeTraceBuffer* anBuffer = new (std::nothrow) typeTraceBuffer();
+      if(NULL != anBuffer)
+      {
+        anBuffer->events = new (std::nothrow) typeTraceEvent[theState.capacity];
+        if(NULL == anBuffer->events)
+        {
+          delete anBuffer;
+          return;
+        }
+        anBuffer->thread = (Uint32)theState.buffers.size() + 1;
+        anBuffer->name = tName;
+        anBuffer->capacity = theState.capacity;
+        anBuffer->count = 0;
+        theState.buffers.push_back(anBuffer);
+        tBuffer = anBuffer;
+      }
+    }
+
+    /**
+     * WriteTraceTime is responsible for writing theTime in nanoseconds since
+     * theStart as the microseconds expected by the trace format.
+     * @param[in] theStream to write the time to
+     * @param[in] theTime to write
+     * @param[in] theStart of the trace
+     */
+    void WriteTraceTime(std::ostream& theStream, Uint64 theTime, Uint64 theStart)
+    {
+      const Uint64 anTime = (theTime > theStart) ? theTime - theStart : 0;
+      const Uint32 anFraction = (Uint32)(anTime % 1000);
+      theStream << anTime / 1000 << '.' << (char)('0' + anFraction / 100)
+        << (char)('0' + anFraction / 10 % 10) << (char)('0' + anFraction % 10);
+    }
+  } // namespace
+
+  void AssetTrace::Start(Uint32 theCapacity)
+  {
+    typeTraceState& anState = GetTraceState();
+    std::lock_guard<std::mutex> anLock(anState.mutex);
+
+    ILOG() << "AssetTrace::Start(" << theCapacity << ")" << std::endl;
+
+    // Throw away the events of any previous trace
+    DeleteBuffers(anState);
+    anState.dropped = 0;
+    anState.capacity = (2 > theCapacity) ? 2 : theCapacity;
+    anState.start = GetTraceTime();
+    anState.recording.store(true, std::memory_order_release);
+  }
+
+  void AssetTrace::Stop(void)
+  {
+    ILOGM("AssetTrace::Stop()");
+    GetTraceState().recording = false;
+  }
+
+  void AssetTrace::Clear(void)
+  {
+    typeTraceState& anState = GetTraceState();
+    std::lock_guard<std::mutex> anLock(anState.mutex);
+    anState.recording = false;
+    DeleteBuffers(anState);
+  }
+
+  bool AssetTrace::IsRecording(void)
+  {
+    return GetTraceState().recording.load(std::memory_order_relaxed);
+  }
+
+  Uint64 AssetTrace::GetDropped(void)
+  {
+    return GetTraceState().dropped;
+  }
+
+  void AssetTrace::SetThreadName(const std::string& theName)
+  {
+    tName = theName;
+
+    // Rename the buffer already created for this thread too
+    typeTraceState& anState = GetTraceState();
+    std::lock_guard<std::mutex> anLock(anState.mutex);
+    if(NULL != tBuffer && tGeneration == anState.generation)
+    {
+      tBuffer->name = theName;
+    }
+  }
+
+  bool AssetTrace::Begin(const char* theName, const char* theCategory)
+  {
+    return IsRecording() && Record('B', theName, theCategory, NULL);
+  }
+
+  bool AssetTrace::Begin(const char* theName, const char* theCategory,
+    const AssetKey& theAssetID)
+  {
+    return IsRecording() && Record('B', theName, theCategory, &theAssetID.GetID());
+  }
+
+  void AssetTrace::End(void)
+  {
+    // Ignore end events whose begin event was recorded by a previous trace
+    if(0 != tOpen &&
+      tGeneration == GetTraceState().generation.load(std::memory_order_acquire))
+    {
+      tOpen--;
+      Record('E', NULL, NULL, NULL);
+    }
+  }
+
+  bool AssetTrace::Record(char thePhase, const char* theName,
+    const char* theCategory, const typeAssetID* theAssetID)
+  {
+    typeTraceState& anState = GetTraceState();
+
+    // Count ourselves as a writer before checking the generation, so
+    // DeleteBuffers either waits for this event or we see the new generation
+    anState.writers++;
+    while(tGeneration != anState.generation)
+    {
+      anState.writers--;
+
+      // Ignore end events whose begin event was recorded by a previous trace
+      if('E' == thePhase)
+      {
+        return false;
+      }
+      CreateBuffer(anState);
+      anState.writers++;
+    }
+
+    // Keep room for the end event of every begin event still open
+    typeTraceBuffer* anBuffer = tBuffer;
+    const Uint32 anCount = (NULL == anBuffer) ? 0 :
+      anBuffer->count.load(std::memory_order_relaxed);
+    if(NULL == anBuffer ||
+      ('B' == thePhase && anCount + tOpen + 2 > anBuffer->capacity))
+    {
+      anState.writers--;
+      anState.dropped++;
+      return false;
+    }
+
+    typeTraceEvent& anEvent = anBuffer->events[anCount];
+    anEvent.time = GetTraceTime();
+    anEvent.name = theName;
+    anEvent.category = theCategory;
+    anEvent.asset = theAssetID;
+    anEvent.phase = thePhase;
+    if('B' == thePhase)
+    {
+      tOpen++;
+    }
+
+    // Publish the event to Write, the buffer may be deleted once we are done
+    anBuffer->count.store(anCount + 1, std::memory_order_release);
+    anState.writers--;
+    return true;
+  }
+
+  void AssetTrace::Write(std::ostream& theStream)
+  {
+    typeTraceState& anState = GetTraceState();
+    std::lock_guard<std::mutex> anLock(anState.mutex);
+
+    theStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    theStream << "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+      << "\"args\":{\"name\":\"GExL\"}}";
+    for(size_t anIndex = 0; anIndex < anState.buffers.size(); anIndex++)
+    {
+      const typeTraceBuffer* anBuffer = anState.buffers[anIndex];
+
+      // Name the thread, loader threads name themselves
+      theStream << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << anBuffer->thread
+        << ",\"name\":\"thread_name\",\"args\":{\"name\":"
+        << StringToJSON(anBuffer->name.empty() ? "Thread" : anBuffer->name)
+        << "}}";
+
+      // Only read the events the thread has published so far
+      const Uint32 anCount = anBuffer->count.load(std::memory_order_acquire);
+      for(Uint32 anEventIndex = 0; anEventIndex < anCount; anEventIndex++)
+      {
+        const typeTraceEvent& anEvent = anBuffer->events[anEventIndex];
+        theStream << ",\n{\"ph\":\"" << anEvent.phase << "\",\"pid\":1,\"tid\":"
+          << anBuffer->thread << ",\"ts\":";
+        WriteTraceTime(theStream, anEvent.time, anState.start);
+        if('B' == anEvent.phase)
+        {
+          theStream << ",\"name\":" << StringToJSON(anEvent.name)
+            << ",\"cat\":" << StringToJSON(anEvent.category);
+          if(NULL != anEvent.asset)
+          {
+            theStream << ",\"args\":{\"asset\":" << StringToJSON(*anEvent.asset)
+              << "}";
+          }
+        }
+        theStream << "}";
+      }
+    }
+    theStream << "\n]}\n";
+  }
+
+  bool AssetTrace::Write(const std::string& theFilename)
+  {
+    std::ofstream anFile(theFilename.c_str());
+    if(false == anFile.is_open())
+    {
+      ELOG() << "AssetTrace::Write(" << theFilename
+        << ") unable to open trace file!" << std::endl;
+      return false;
+    }
+
+    ILOG() << "AssetTrace::Write(" << theFilename << ")" << std::endl;
+
+    Write(anFile);
+    return anFile.good();
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,235 @@
+/**
+* Provides the AssetWatcher class in the GExL namespace which is responsible
+* for watching asset directories for files that change on disk.
+*
+* @file src/GExL/assets/AssetWatcher.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <GExL/assets/AssetWatcher.hpp>
+#include <GExL/logger/Log_macros.hpp>
+#if defined(GExL_LINUX)
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GExL
+{
+  AssetWatcher::AssetWatcher() :
+    mRunning(false),
+    mHandle(-1)
+  {
+    ILOGM("AssetWatcher::ctor()");
+  }
+
+  AssetWatcher::~AssetWatcher()
+  {
+    ILOGM("AssetWatcher::dtor()");
+
+    // Stop the watcher thread and close every watch
+    Stop();
+  }
+
+  bool AssetWatcher::Watch(const std::string& theDirectory)
+  {
+#if defined(GExL_LINUX)
+    std::lock_guard<std::mutex> anLock(mMutex);
+
+    // Open the inotify instance the first time a directory is watched
+    if(0 > mHandle)
+    {
+      mHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if(0 > mHandle)
+      {
+        ELOG() << "AssetWatcher::Watch(" << theDirectory
+          << ") unable to create inotify instance!" << std::endl;
+        return false;
+      }
+    }
+
+    if(false == AddDirectory(theDirectory))
+    {
+      ELOG() << "AssetWatcher::Watch(" << theDirectory
+        << ") unable to watch directory!" << std::endl;
+      return false;
+    }
+
+    ILOG() << "AssetWatcher::Watch(" << theDirectory << ")" << std::endl;
+
+    // Start the watcher thread once something is being watched
+    if(false == mRunning)
+    {
+      mRunning = true;
+      mThread = std::thread(&AssetWatcher::Run, this);
+    }
+    return true;
+#else
+    WLOG() << "AssetWatcher::Watch(" << theDirectory
+      << ") watching files is not supported on this platform" << std::endl;
+    return false;
+#endif
+  }
+
+  void AssetWatcher::Stop(void)
+  {
+    // Wait for the watcher thread to notice it should exit
+    mRunning = false;
+    if(mThread.joinable())
+    {
+      mThread.join();
+    }
+
+    std::lock_guard<std::mutex> anLock(mMutex);
+#if defined(GExL_LINUX)
+    // Closing the inotify instance removes every watch
+    if(0 <= mHandle)
+    {
+      close(mHandle);
+    }
+#endif
+    mHandle = -1;
+    mDirectories.clear();
+    mChanges.clear();
+  }
+
+  bool AssetWatcher::IsWatching(void) const
+  {
+    return mRunning;
+  }
+
+  void AssetWatcher::GetChanges(std::vector<std::string>& theFilenames)
+  {
+    std::lock_guard<std::mutex> anLock(mMutex);
+    theFilenames.insert(theFilenames.end(), mChanges.begin(), mChanges.end());
+    mChanges.clear();
+  }
+
+  bool AssetWatcher::AddDirectory(const std::string& theDirectory)
+  {
+#if defined(GExL_LINUX)
+    // Watch for files being written or moved into place and new directories
+    int anWatch = inotify_add_watch(mHandle, theDirectory.c_str(),
+      IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if(0 > anWatch)
+    {
+      return false;
+    }
+    mDirectories[anWatch] = theDirectory;
+
+    // Watch every directory below theDirectory as well
+    DIR* anDirectory = opendir(theDirectory.c_str());
+    if(NULL != anDirectory)
+    {
+      for(struct dirent* anEntry = readdir(anDirectory); NULL != anEntry;
+        anEntry = readdir(anDirectory))
+      {
+        std::string anName = anEntry->d_name;
+        std::string anPath = theDirectory + "/" + anName;
+        struct stat anStat;
+        if("." != anName && ".." != anName &&
+          0 == stat(anPath.c_str(), &anStat) && S_ISDIR(anStat.st_mode))
+        {
+          AddDirectory(anPath);
+        }
+      }
+      closedir(anDirectory);
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void AssetWatcher::Run(void)
+  {
+#if defined(GExL_LINUX)
+    // Buffer big enough for many events, aligned for struct inotify_event
+    union
+    {
+      struct inotify_event event;
+      char bytes[16384];
+    } anBuffer;
+
+    while(mRunning)
+    {
+      // Wake up regularly so Stop doesn't have to wait long
+      struct pollfd anPoll;
+      anPoll.fd = mHandle;
+      anPoll.events = POLLIN;
+      anPoll.revents = 0;
+      if(0 >= poll(&anPoll, 1, 100))
+      {
+        continue;
+      }
+
+      ssize_t anSize = read(mHandle, anBuffer.bytes, sizeof(anBuffer.bytes));
+      if(0 >= anSize)
+      {
+        continue;
+      }
+
+      // Note each changed file, watching any new directory too
+      std::lock_guard<std::mutex> anLock(mMutex);
+      for(ssize_t anOffset = 0; anOffset < anSize;)
+      {
+        const struct inotify_event* anEvent =
+          reinterpret_cast<const struct inotify_event*>(anBuffer.bytes + anOffset);
+        anOffset += sizeof(struct inotify_event) + anEvent->len;
+
+        std::map<int, std::string>::iterator iter = mDirectories.find(anEvent->wd);
+        if(iter == mDirectories.end())
+        {
+          continue;
+        }
+        if(0 != (anEvent->mask & IN_IGNORED))
+        {
+          mDirectories.erase(iter);
+          continue;
+        }
+        if(0 == anEvent->len)
+        {
+          continue;
+        }
+
+        std::string anPath = iter->second + "/" + anEvent->name;
+        if(0 != (anEvent->mask & IN_ISDIR))
+        {
+          if(0 != (anEvent->mask & (IN_CREATE | IN_MOVED_TO)))
+          {
+            AddDirectory(anPath);
+          }
+        }
+        else if(0 != (anEvent->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+        {
+          mChanges.insert(anPath);
+        }
+      }
+    }
+#endif
+  }
+} // namespace GExL
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
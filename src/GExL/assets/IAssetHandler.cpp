@@ -8,13 +8,19 @@
 */
 
 #include <assert.h>
+#include <atomic>
+#include <set>
 #include <GExL/assets/IAssetHandler.hpp>
+#include <GExL/assets/AssetManager.hpp>
 #include <GExL/logger/Log_macros.hpp>
 
 namespace GExL
 {
-  IAssetHandler::IAssetHandler(const typeAssetHandlerID theAssetHandlerID) :
-    mAssetHandlerID(theAssetHandlerID)
+  IAssetHandler::IAssetHandler(const typeAssetHandlerID theAssetHandlerID,
+    Uint32 theTypeIndex) :
+    mAssetHandlerID(theAssetHandlerID),
+    mTypeIndex(theTypeIndex),
+    mAssetManager(NULL)
   {
     ILOG() << "IAssetHandler::ctor(" << mAssetHandlerID << ")" << std::endl;
   }
@@ -28,6 +34,115 @@ namespace GExL
   {
     return mAssetHandlerID;
   }
+
+  Uint32 IAssetHandler::GetTypeIndex(void) const
+  {
+    return mTypeIndex;
+  }
+
+  Uint32 IAssetHandler::NextTypeIndex(void)
+  {
+    // Next type index to hand out, shared by every asset TYPE
+    static std::atomic<Uint32> sNextTypeIndex(0);
+
+    return sNextTypeIndex++;
+  }
+
+  AssetManager* IAssetHandler::GetAssetManager(void) const
+  {
+    return mAssetManager;
+  }
+
+  bool IAssetHandler::IsFinalizeThread(void) const
+  {
+    return NULL == mAssetManager || mAssetManager->IsFinalizeThread();
+  }
+
+  bool IAssetHandler::AddLoadTask(AssetLoader::typeLoadTask theTask,
+    AssetLoadPriority thePriority)
+  {
+    // Result will be true if theTask was queued
+    bool anResult = false;
+
+    // Were we registered with an AssetManager? then use its loader threads
+    if(NULL != mAssetManager)
+    {
+      mAssetManager->GetLoader().AddTask(theTask, thePriority);
+      anResult = true;
+    }
+
+    // Return anResult which is false if the caller should run theTask itself
+    return anResult;
+  }
+
+  void IAssetHandler::CheckGlobalMemoryBudget(void)
+  {
+    // Were we registered with an AssetManager? then let it check its budget
+    if(NULL != mAssetManager)
+    {
+      mAssetManager->CheckMemoryBudget();
+    }
+  }
+
+  bool IAssetHandler::GetPackData(const AssetKey& theAssetID, AssetSpan& theSpan,
+    std::vector<Uint8>& theBuffer) const
+  {
+    // Result will be true if theAssetID was found in a mounted pack
+    bool anResult = false;
+
+    // Were we registered with an AssetManager? then search its packs
+    if(NULL != mAssetManager)
+    {
+      anResult = mAssetManager->FindPackData(theAssetID, theSpan, theBuffer);
+    }
+
+    // Return anResult which is false if theAssetID was not found
+    return anResult;
+  }
+
+  IAssetHandler* IAssetHandler::FindHandler(
+    const typeAssetHandlerID theAssetHandlerID) const
+  {
+    // Result will be the handler found or NULL
+    IAssetHandler* anResult = NULL;
+
+    // Were we registered with an AssetManager? then ask it for the handler
+    if(NULL != mAssetManager)
+    {
+      anResult = mAssetManager->FindHandler(theAssetHandlerID);
+    }
+
+    // Return anResult which is NULL if no handler was found
+    return anResult;
+  }
+
+  bool IAssetHandler::IsDependency(const AssetKey& theAssetID,
+    const IAssetHandler& theHandler, const AssetKey& theDependencyID) const
+  {
+    // Assets still to visit and assets already visited
+    std::vector<typeAssetDependency> anVisit;
+    std::set<std::pair<const IAssetHandler*, Uint64> > anVisited;
+    GetDependencies(theAssetID, anVisit);
+
+    // Walk the dependencies depth first looking for theDependencyID
+    while(false == anVisit.empty())
+    {
+      const typeAssetDependency anAsset = anVisit.back();
+      anVisit.pop_back();
+      if(&theHandler == anAsset.handler && theDependencyID == anAsset.key)
+      {
+        return true;
+      }
+      if(anVisited.insert(std::make_pair(anAsset.handler,
+        anAsset.key.GetHash())).second)
+      {
+        anAsset.handler->GetDependencies(anAsset.key, anVisit);
+      }
+    }
+
+    // Return false, theDependencyID was not found
+    return false;
+  }
 } // namespace GExL
 /**
  * Copyright (c) 2010-2012 Ryan Lindeman
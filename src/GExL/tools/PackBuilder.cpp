@@ -0,0 +1,436 @@
+/**
+* Provides the gexl-pack command line tool which writes every file found in
+* a directory into a single GExL asset pack file (see AssetPack) along with a
+* manifest of each asset ID and where it was stored.
+*
+* @file src/GExL/tools/PackBuilder.cpp
+* @author Jacob Dix
+* @date 20261017 - Initial Release
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <GExL/assets/AssetKey.hpp>
+#include <GExL/assets/AssetPack.hpp>
+#if defined(GExL_WINDOWS)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+  /// Structure holding each file found in the input directory
+  struct typeInputFile {
+    GExL::typeAssetID assetID; ///< Asset ID, the path relative to the input directory
+    std::string       path;    ///< Path used to open the file
+  };
+
+  /// Structure holding each blob written to the pack file
+  struct typeBlob {
+    std::string  path;       ///< First file written to this blob
+    GExL::Uint64 offset;     ///< Offset of the blob from the start of the pack
+    GExL::Uint64 storedSize; ///< Number of bytes written for the blob
+    GExL::Uint64 size;       ///< Number of bytes in the file
+    GExL::Uint32 flags;      ///< Storage flags, 0 or AssetPack::ENTRY_COMPRESSED
+  };
+
+  /// Structure holding each table of contents entry written to the pack file
+  struct typeTocEntry {
+    GExL::Uint64      hash;    ///< Hash of the asset ID
+    GExL::typeAssetID assetID; ///< Asset ID, only used for messages
+    size_t            blob;    ///< Index of the blob holding the asset bytes
+  };
+
+  /**
+   * SortByAssetID is used to sort the input files so packs are reproducible.
+   */
+  bool SortByAssetID(const typeInputFile& theLeft, const typeInputFile& theRight)
+  {
+    return theLeft.assetID < theRight.assetID;
+  }
+
+  /**
+   * SortByHash is used to sort the table of contents for AssetPack::Find.
+   */
+  bool SortByHash(const typeTocEntry& theLeft, const typeTocEntry& theRight)
+  {
+    return theLeft.hash < theRight.hash;
+  }
+
+  /**
+   * FindFiles is responsible for adding every file found under theDirectory
+   * to theFiles, recursing into each sub directory.
+   * @param[in] theDirectory to search
+   * @param[in] thePrefix to add to the asset ID of each file found
+   * @param[out] theFiles to add each file found to
+   * @return true if theDirectory could be read, false otherwise
+   */
+  bool FindFiles(const std::string& theDirectory, const std::string& thePrefix,
+    std::vector<typeInputFile>& theFiles)
+  {
+#if defined(GExL_WINDOWS)
+    WIN32_FIND_DATAA anFindData;
+    HANDLE anFind = FindFirstFileA((theDirectory + "\\*").c_str(), &anFindData);
+    if(INVALID_HANDLE_VALUE == anFind)
+    {
+      return false;
+    }
+    do
+    {
+      std::string anName = anFindData.cFileName;
+      if("." == anName || ".." == anName)
+      {
+        continue;
+      }
+      std::string anPath = theDirectory + "\\" + anName;
+      if(0 != (anFindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+      {
+        FindFiles(anPath, thePrefix + anName + "/", theFiles);
+      }
+      else
+      {
+        typeInputFile anFile;
+        anFile.assetID = thePrefix + anName;
+        anFile.path = anPath;
+        theFiles.push_back(anFile);
+      }
+    } while(FALSE != FindNextFileA(anFind, &anFindData));
+    FindClose(anFind);
+#else
+    DIR* anDirectory = opendir(theDirectory.c_str());
+    if(NULL == anDirectory)
+    {
+      return false;
+    }
+    for(struct dirent* anEntry = readdir(anDirectory); NULL != anEntry;
+      anEntry = readdir(anDirectory))
+    {
+      std::string anName = anEntry->d_name;
+      if("." == anName || ".." == anName)
+      {
+        continue;
+      }
+      std::string anPath = theDirectory + "/" + anName;
+      struct stat anStat;
+      if(0 != stat(anPath.c_str(), &anStat))
+      {
+        continue;
+      }
+      if(S_ISDIR(anStat.st_mode))
+      {
+        FindFiles(anPath, thePrefix + anName + "/", theFiles);
+      }
+      else if(S_ISREG(anStat.st_mode))
+      {
+        typeInputFile anFile;
+        anFile.assetID = thePrefix + anName;
+        anFile.path = anPath;
+        theFiles.push_back(anFile);
+      }
+    }
+    closedir(anDirectory);
+#endif
+    return true;
+  }
+
+  /**
+   * ReadFile is responsible for reading every byte of thePath into theData.
+   * @param[in] thePath of the file to read
+   * @param[out] theData to hold the bytes read
+   * @return true if the file was read, false otherwise
+   */
+  bool ReadFile(const std::string& thePath, std::vector<GExL::Uint8>& theData)
+  {
+    std::ifstream anFile(thePath.c_str(), std::ios::in | std::ios::binary);
+    if(false == anFile.is_open())
+    {
+      return false;
+    }
+    anFile.seekg(0, std::ios::end);
+    theData.resize((size_t)anFile.tellg());
+    anFile.seekg(0, std::ios::beg);
+    if(false == theData.empty())
+    {
+      anFile.read(reinterpret_cast<char*>(&theData[0]), (std::streamsize)theData.size());
+    }
+    return false == anFile.fail();
+  }
+
+  /**
+   * AppendLittle will append the theBytes low bytes of theValue to theResult
+   * in little endian byte order as expected by AssetPack.
+   * @param[in] theValue to append
+   * @param[in] theBytes number of bytes of theValue to append
+   * @param[out] theResult to append to
+   */
+  void AppendLittle(GExL::Uint64 theValue, size_t theBytes,
+    std::vector<GExL::Uint8>& theResult)
+  {
+    for(size_t anIndex = 0; anIndex < theBytes; anIndex++)
+    {
+      theResult.push_back((GExL::Uint8)(theValue >> (anIndex * 8)));
+    }
+  }
+
+  /**
+   * WritePadding will write zero bytes to theFile until theOffset is a
+   * multiple of theAlignment.
+   * @param[in] theFile to write to
+   * @param[in,out] theOffset of the end of theFile
+   * @param[in] theAlignment required (must be a power of two)
+   */
+  void WritePadding(std::ofstream& theFile, GExL::Uint64& theOffset,
+    GExL::Uint64 theAlignment)
+  {
+    while(0 != (theOffset & (theAlignment - 1)))
+    {
+      theFile.put(0);
+      theOffset++;
+    }
+  }
+
+  /**
+   * PrintUsage will write the command line options to standard error.
+   */
+  void PrintUsage(void)
+  {
+    std::cerr << "usage: gexl-pack [-c] [-a alignment] [-m manifest] <input directory> <output pack>" << std::endl
+      << "  -c            compress each file that gets smaller when compressed" << std::endl
+      << "  -a alignment  alignment of each asset in the pack (default "
+      << GExL::AssetPack::PACK_ALIGNMENT << ")" << std::endl
+      << "  -m manifest   manifest filename (default <output pack>.manifest)" << std::endl;
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  // Parse the command line options
+  bool anCompress = false;
+  GExL::Uint64 anAlignment = GExL::AssetPack::PACK_ALIGNMENT;
+  std::string anManifest;
+  std::vector<std::string> anArguments;
+  for(int anIndex = 1; anIndex < argc; anIndex++)
+  {
+    std::string anArgument = argv[anIndex];
+    if("-c" == anArgument)
+    {
+      anCompress = true;
+    }
+    else if("-a" == anArgument && anIndex + 1 < argc)
+    {
+      anAlignment = (GExL::Uint64)strtoul(argv[++anIndex], NULL, 10);
+    }
+    else if("-m" == anArgument && anIndex + 1 < argc)
+    {
+      anManifest = argv[++anIndex];
+    }
+    else
+    {
+      anArguments.push_back(anArgument);
+    }
+  }
+  if(2 != anArguments.size() || 0 == anAlignment || 0 != (anAlignment & (anAlignment - 1)))
+  {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+  const std::string anInput = anArguments[0];
+  const std::string anOutput = anArguments[1];
+  if(anManifest.empty())
+  {
+    anManifest = anOutput + ".manifest";
+  }
+
+  // Find every file in the input directory
+  std::vector<typeInputFile> anFiles;
+  if(false == FindFiles(anInput, "", anFiles))
+  {
+    std::cerr << "gexl-pack: unable to read directory " << anInput << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::sort(anFiles.begin(), anFiles.end(), SortByAssetID);
+
+  std::ofstream anPack(anOutput.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(false == anPack.is_open())
+  {
+    std::cerr << "gexl-pack: unable to create " << anOutput << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Leave room for the header which is written once the offsets are known
+  GExL::Uint64 anOffset = sizeof(GExL::AssetPack::typePackHeader);
+  anPack.write(std::string((size_t)anOffset, '\0').data(), (std::streamsize)anOffset);
+
+  // Write each unique file as an aligned blob
+  std::vector<typeBlob> anBlobs;
+  std::vector<typeTocEntry> anEntries;
+  std::multimap<GExL::Uint64, size_t> anContents;
+  GExL::Uint64 anInputBytes = 0;
+  for(size_t anIndex = 0; anIndex < anFiles.size(); anIndex++)
+  {
+    std::vector<GExL::Uint8> anData;
+    if(false == ReadFile(anFiles[anIndex].path, anData))
+    {
+      std::cerr << "gexl-pack: unable to read " << anFiles[anIndex].path << std::endl;
+      return EXIT_FAILURE;
+    }
+    anInputBytes += anData.size();
+
+    typeTocEntry anEntry;
+    anEntry.hash = GExL::HashAssetID(anFiles[anIndex].assetID.c_str());
+    anEntry.assetID = anFiles[anIndex].assetID;
+    anEntry.blob = anBlobs.size();
+
+    // Reuse the blob of an earlier file with identical bytes
+    const GExL::Uint64 anContentHash = GExL::HashAssetData(
+      anData.empty() ? NULL : &anData[0], anData.size());
+    std::multimap<GExL::Uint64, size_t>::const_iterator iter =
+      anContents.lower_bound(anContentHash);
+    for(; iter != anContents.end() && iter->first == anContentHash; iter++)
+    {
+      std::vector<GExL::Uint8> anOther;
+      if(anBlobs[iter->second].size == anData.size() &&
+        ReadFile(anBlobs[iter->second].path, anOther) && anOther == anData)
+      {
+        anEntry.blob = iter->second;
+        break;
+      }
+    }
+
+    if(anEntry.blob == anBlobs.size())
+    {
+      typeBlob anBlob;
+      anBlob.path = anFiles[anIndex].path;
+      anBlob.size = anData.size();
+      anBlob.flags = 0;
+
+      // Only keep the compressed bytes if they are smaller
+      std::vector<GExL::Uint8> anCompressed;
+      if(anCompress && false == anData.empty())
+      {
+        GExL::AssetPack::Compress(&anData[0], anData.size(), anCompressed);
+        if(anCompressed.size() < anData.size())
+        {
+          anData.swap(anCompressed);
+          anBlob.flags = GExL::AssetPack::ENTRY_COMPRESSED;
+        }
+      }
+
+      WritePadding(anPack, anOffset, anAlignment);
+      anBlob.offset = anOffset;
+      anBlob.storedSize = anData.size();
+      if(false == anData.empty())
+      {
+        anPack.write(reinterpret_cast<const char*>(&anData[0]), (std::streamsize)anData.size());
+      }
+      anOffset += anData.size();
+
+      anContents.insert(std::make_pair(anContentHash, anBlobs.size()));
+      anBlobs.push_back(anBlob);
+    }
+    anEntries.push_back(anEntry);
+  }
+
+  // Two asset ID's with the same hash could never be told apart at run time
+  std::sort(anEntries.begin(), anEntries.end(), SortByHash);
+  for(size_t anIndex = 1; anIndex < anEntries.size(); anIndex++)
+  {
+    if(anEntries[anIndex - 1].hash == anEntries[anIndex].hash)
+    {
+      std::cerr << "gexl-pack: asset ID hash collision between "
+        << anEntries[anIndex - 1].assetID << " and " << anEntries[anIndex].assetID
+        << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Write the table of contents sorted by hash after the blobs
+  WritePadding(anPack, anOffset, 8);
+  const GExL::Uint64 anTocOffset = anOffset;
+  std::vector<GExL::Uint8> anToc;
+  for(size_t anIndex = 0; anIndex < anEntries.size(); anIndex++)
+  {
+    const typeBlob& anBlob = anBlobs[anEntries[anIndex].blob];
+    AppendLittle(anEntries[anIndex].hash, 8, anToc);
+    AppendLittle(anBlob.offset, 8, anToc);
+    AppendLittle(anBlob.storedSize, 8, anToc);
+    AppendLittle(anBlob.size, 8, anToc);
+    AppendLittle(anBlob.flags, 4, anToc);
+    AppendLittle(0, 4, anToc);
+  }
+  if(false == anToc.empty())
+  {
+    anPack.write(reinterpret_cast<const char*>(&anToc[0]), (std::streamsize)anToc.size());
+  }
+  anOffset += anToc.size();
+
+  // Now the header can be written
+  std::vector<GExL::Uint8> anHeader(8);
+  memcpy(&anHeader[0], "GEXLPACK", 8);
+  AppendLittle(GExL::AssetPack::PACK_VERSION, 4, anHeader);
+  AppendLittle(anEntries.size(), 4, anHeader);
+  AppendLittle(anTocOffset, 8, anHeader);
+  AppendLittle(anAlignment, 4, anHeader);
+  AppendLittle(0, 4, anHeader);
+  anPack.seekp(0, std::ios::beg);
+  anPack.write(reinterpret_cast<const char*>(&anHeader[0]), (std::streamsize)anHeader.size());
+  anPack.close();
+  if(anPack.fail())
+  {
+    std::cerr << "gexl-pack: unable to write " << anOutput << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Write the manifest of every asset ID in the pack
+  std::ofstream anList(anManifest.c_str(), std::ios::out | std::ios::trunc);
+  if(false == anList.is_open())
+  {
+    std::cerr << "gexl-pack: unable to create " << anManifest << std::endl;
+    return EXIT_FAILURE;
+  }
+  anList << "# assetID offset size storedSize flags" << std::endl;
+  for(size_t anIndex = 0; anIndex < anFiles.size(); anIndex++)
+  {
+    typeTocEntry anFind;
+    anFind.hash = GExL::HashAssetID(anFiles[anIndex].assetID.c_str());
+    const typeBlob& anBlob = anBlobs[std::lower_bound(anEntries.begin(),
+      anEntries.end(), anFind, SortByHash)->blob];
+    anList << anFiles[anIndex].assetID << " " << anBlob.offset << " "
+      << anBlob.size << " " << anBlob.storedSize << " " << anBlob.flags << std::endl;
+  }
+
+  std::cout << "gexl-pack: wrote " << anEntries.size() << " assets ("
+    << anBlobs.size() << " unique) " << anInputBytes << " bytes into "
+    << anOffset << " bytes " << anOutput << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Copyright (c) 2014-2026 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
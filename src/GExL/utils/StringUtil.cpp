@@ -27,6 +27,33 @@ namespace GExL
     return anUpperString;
   }
 
+  std::string StringToJSON(const std::string& theString)
+  {
+    static const char* const anDigits = "0123456789abcdef";
+    std::string anJSONString = "\"";
+    for(size_t anIndex = 0; anIndex < theString.size(); anIndex++)
+    {
+      const unsigned char anChar = (unsigned char)theString[anIndex];
+      if('"' == anChar || '\\' == anChar)
+      {
+        anJSONString += '\\';
+        anJSONString += (char)anChar;
+      }
+      else if(0x20 > anChar)
+      {
+        anJSONString += "\\u00";
+        anJSONString += anDigits[anChar >> 4];
+        anJSONString += anDigits[anChar & 0xF];
+      }
+      else
+      {
+        anJSONString += (char)anChar;
+      }
+    }
+    anJSONString += '"';
+    return anJSONString;
+  }
+
   std::string GetDateString()
   {
     time_t anRawTime;